@@ -169,6 +169,10 @@ else(USE_CONAN)
 	)
 endif(USE_CONAN)
 
+# worker threads of the asynchronous interface
+find_package(Threads REQUIRED)
+list(APPEND OFIQ_LINK_LIB_LIST Threads::Threads)
+
 add_library (ofiq_objlib OBJECT
 	${module_sources}
 	${thirdParty_sources}
@@ -194,6 +198,12 @@ target_link_libraries(OFIQSampleApp
 	PRIVATE ${OFIQ_LINK_LIB_LIST}
 )
 
+add_executable(OFIQRescoreApp ${OFIQLIB_SOURCE_DIR}/src/OFIQRescoreApp.cpp)
+target_link_libraries(OFIQRescoreApp
+	PRIVATE ofiq_lib
+	PRIVATE ${OFIQ_LINK_LIB_LIST}
+)
+
 add_executable(OFIQ_zmq_app ${OFIQLIB_SOURCE_DIR}/src/OFIQ_zmq_app.cpp)
 target_link_libraries(OFIQ_zmq_app
 	PRIVATE ofiq_lib
@@ -220,6 +230,11 @@ install(TARGETS OFIQSampleApp
 	DESTINATION Release/bin
 )
 
+install(TARGETS OFIQRescoreApp
+	CONFIGURATIONS Release
+	DESTINATION Release/bin
+)
+
 install(TARGETS OFIQ_zmq_app
 	CONFIGURATIONS Release
 	DESTINATION Release/bin
@@ -242,6 +257,11 @@ install(TARGETS OFIQSampleApp
 	DESTINATION Debug/bin
 )
 
+install(TARGETS OFIQRescoreApp
+	CONFIGURATIONS Debug
+	DESTINATION Debug/bin
+)
+
 install(TARGETS OFIQ_zmq_app
 	CONFIGURATIONS Debug
 	DESTINATION Debug/bin
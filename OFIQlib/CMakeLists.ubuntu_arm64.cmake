@@ -147,6 +147,10 @@ else(USE_CONAN)
 	)
 endif(USE_CONAN)
 
+# worker threads of the asynchronous interface
+find_package(Threads REQUIRED)
+list(APPEND OFIQ_LINK_LIB_LIST Threads::Threads)
+
 add_library (ofiq_objlib OBJECT
 	${module_sources}
 	${thirdParty_sources}
@@ -172,6 +176,12 @@ target_link_libraries(OFIQSampleApp
 	PRIVATE ${OFIQ_LINK_LIB_LIST}
 )
 
+add_executable(OFIQRescoreApp ${OFIQLIB_SOURCE_DIR}/src/OFIQRescoreApp.cpp)
+target_link_libraries(OFIQRescoreApp
+	PRIVATE ofiq_lib
+	PRIVATE ${OFIQ_LINK_LIB_LIST}
+)
+
 
 set_target_properties(ofiq_lib 
         PROPERTIES PUBLIC_HEADER "${PUBLIC_HEADER_LIST}"
@@ -192,6 +202,11 @@ install(TARGETS OFIQSampleApp
 	DESTINATION Release/bin
 )
 
+install(TARGETS OFIQRescoreApp
+	CONFIGURATIONS Release
+	DESTINATION Release/bin
+)
+
 install(TARGETS ofiq_lib
 	CONFIGURATIONS Release
     DESTINATION Release/lib
@@ -209,6 +224,11 @@ install(TARGETS OFIQSampleApp
 	DESTINATION Debug/bin
 )
 
+install(TARGETS OFIQRescoreApp
+	CONFIGURATIONS Debug
+	DESTINATION Debug/bin
+)
+
 install(TARGETS ofiq_lib
 	CONFIGURATIONS Debug
     DESTINATION Debug/lib
@@ -164,6 +164,10 @@ else(USE_CONAN)
 		onnxruntime)
 endif(USE_CONAN)
 
+# worker threads of the asynchronous interface
+find_package(Threads REQUIRED)
+list(APPEND OFIQ_LINK_LIB_LIST Threads::Threads)
+
 
 add_library (ofiq_objlib OBJECT
 	${module_sources}
@@ -195,6 +199,12 @@ target_link_libraries(OFIQSampleApp
 	PRIVATE ${OFIQ_LINK_LIB_LIST}
 )
 
+add_executable(OFIQRescoreApp ${OFIQLIB_SOURCE_DIR}/src/OFIQRescoreApp.cpp)
+target_link_libraries(OFIQRescoreApp
+	PRIVATE ofiq_lib
+	PRIVATE ${OFIQ_LINK_LIB_LIST}
+)
+
 add_executable(OFIQ_zmq_app ${OFIQLIB_SOURCE_DIR}/src/OFIQ_zmq_app.cpp)
 target_link_libraries(OFIQ_zmq_app
 	PRIVATE ofiq_lib
@@ -213,6 +223,10 @@ install(TARGETS OFIQSampleApp
         RUNTIME DESTINATION $<CONFIG>/bin
 )
 
+install(TARGETS OFIQRescoreApp
+        RUNTIME DESTINATION $<CONFIG>/bin
+)
+
 install(TARGETS OFIQ_zmq_app
         RUNTIME DESTINATION $<CONFIG>/bin
 )
@@ -0,0 +1,171 @@
+/**
+ * @file ofiq_async.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Asynchronous interface to the OFIQ backed by a pool of worker threads.
+ * @author OFIQ development team
+ */
+#ifndef OFIQ_ASYNC_H
+#define OFIQ_ASYNC_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+#include <ofiq_lib.h>
+
+/**
+ * @brief Namespace for OFIQ API.
+ */
+namespace OFIQ
+{
+    /**
+     * @brief Result of an asynchronous quality assessment.
+     */
+    struct AsyncAssessmentResult
+    {
+        /** @brief Status returned by the assessment, see \link OFIQ::Interface::vectorQuality Interface::vectorQuality\endlink. */
+        ReturnStatus status;
+
+        /** @brief Quality assessment of the submitted image. */
+        FaceImageQualityAssessment assessment;
+    };
+
+    /**
+     * @brief Function receiving the result of an asynchronous quality assessment.
+     * @details The function is invoked on a worker thread; it should return quickly
+     * and must not submit further images synchronously waiting for their results.
+     */
+    using AssessmentCallback = std::function<void(AsyncAssessmentResult&&)>;
+
+    /**
+     * @brief Asynchronous interface to the OFIQ.
+     *
+     * @details Submitted images are put into a bounded queue and assessed by a pool of worker threads.
+     * Each worker owns an \link OFIQ::Interface Interface\endlink object initialized with the same
+     * configuration, so the models are loaded once per worker. If the queue is full,
+     * \link submit \endlink blocks until a worker has taken a queued image. On destruction, queued
+     * images are still assessed before the workers are stopped.
+     */
+    class AsyncInterface
+    {
+    public:
+        /**
+         * @brief Constructor
+         * 
+         * @param numberOfWorkers Number of worker threads, each owning its own set of models; at least 1.
+         * @param queueCapacity Maximum number of images waiting for a worker; at least 1.
+         */
+        OFIQ_EXPORT explicit AsyncInterface(size_t numberOfWorkers = 1, size_t queueCapacity = 16);
+
+        /**
+         * @brief Destructor; completes the queued assessments and stops the workers.
+         */
+        OFIQ_EXPORT ~AsyncInterface();
+
+        /**
+         * @brief Copying is not supported.
+         */
+        AsyncInterface(const AsyncInterface&) = delete;
+
+        /**
+         * @brief Copying is not supported.
+         * @return Reference to this object.
+         */
+        AsyncInterface& operator=(const AsyncInterface&) = delete;
+
+        /**
+         * @brief Initializes the implementations of all workers and starts the workers.
+         *
+         * @param[in] configDir
+         * string representation of the directory containing the configuration file
+         * @param[in] configFileName
+         * An string value encoding the JAXN configuration file name
+         * @return OFIQ::ReturnStatus indicating if the initialization of all workers was successful.
+         */
+        OFIQ_EXPORT ReturnStatus initialize(const std::string& configDir, const std::string& configFileName);
+
+        /**
+         * @brief Submits an image for quality assessment.
+         *
+         * @param[in] image
+         * Single face image. Its data is shared, not copied, and must not be modified until the
+         * assessment is complete.
+         * @return Future receiving the result of the assessment.
+         */
+        OFIQ_EXPORT std::future<AsyncAssessmentResult> submit(const Image& image);
+
+        /**
+         * @brief Submits an image for quality assessment and invokes a callback on completion.
+         *
+         * @param[in] image
+         * Single face image. Its data is shared, not copied, and must not be modified until the
+         * assessment is complete.
+         * @param[in] callback
+         * Function receiving the result of the assessment on a worker thread.
+         */
+        OFIQ_EXPORT void submit(const Image& image, AssessmentCallback callback);
+
+        /**
+         * @brief Submits an image for quality assessment reporting intermediate results.
+         *
+         * @param[in] image
+         * Single face image. Its data is shared, not copied, and must not be modified until the
+         * assessment is complete.
+         * @param[in] progress
+         * Callbacks receiving intermediate results on a worker thread, see
+         * \link OFIQ::Interface::vectorQualityWithProgress Interface::vectorQualityWithProgress\endlink.
+         * @param[in] callback
+         * Function receiving the result of the assessment on a worker thread.
+         */
+        OFIQ_EXPORT void submit(const Image& image, AssessmentProgress progress, AssessmentCallback callback);
+
+        /**
+         * @brief Submits an image for quality assessment that is aborted on cancellation or when its deadline has passed.
+         * @details Images whose deadline passes while they are queued are not assessed; the result reports
+         * \link OFIQ::ReturnCode::DeadlineExceeded ReturnCode::DeadlineExceeded\endlink.
+         *
+         * @param[in] image
+         * Single face image. Its data is shared, not copied, and must not be modified until the
+         * assessment is complete.
+         * @param[in] cancellation
+         * Token and deadline aborting the assessment, see
+         * \link OFIQ::Interface::vectorQualityWithCancellation Interface::vectorQualityWithCancellation\endlink.
+         * @return Future receiving the result of the assessment.
+         */
+        OFIQ_EXPORT std::future<AsyncAssessmentResult> submit(const Image& image, AssessmentCancellation cancellation);
+
+    private:
+        /**
+         * @brief Worker pool and request queue.
+         */
+        struct Impl;
+
+        /**
+         * @brief Pointer to the worker pool and request queue.
+         */
+        std::unique_ptr<Impl> m_impl;
+    };
+}
+
+#endif /* OFIQ_ASYNC_H */
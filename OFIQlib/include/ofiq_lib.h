@@ -27,7 +27,11 @@
 #ifndef OFIQ_LIB_H
 #define OFIQ_LIB_H
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -110,6 +114,79 @@ namespace OFIQ
         All = 0x1 + 0x2 + 0x4 + 0x8 + 0x10
     };
 
+    /**
+     * @brief Callbacks reporting intermediate results of a quality assessment.
+     * @details The callbacks are invoked on the thread running the assessment as soon as a
+     * pre-processing result or the result of a measure is available. If a callback returns false,
+     * the assessment is cancelled: no further pre-processing stages and measures are run, the
+     * remaining measures are returned with the code
+     * \link OFIQ::QualityMeasureReturnCode::Skipped QualityMeasureReturnCode::Skipped\endlink and the
+     * assessment returns \link OFIQ::ReturnCode::Cancelled ReturnCode::Cancelled\endlink.
+     * @see \link OFIQ::Interface::vectorQualityWithProgress Interface::vectorQualityWithProgress\endlink
+     */
+    struct AssessmentProgress
+    {
+        /**
+         * @brief Invoked when a pre-processing result is available; may be empty.
+         * @details Reports the values Faces, Landmarks, LandmarkedRegion, Segmentation and OcclusionMask
+         * of \link OFIQ::PreprocessingResultType PreprocessingResultType\endlink. The second argument holds
+         * the reported artifact only, in the same representation as returned by
+         * \link OFIQ::Interface::vectorQualityWithPreprocessingResults vectorQualityWithPreprocessingResults\endlink:
+         * <code>m_faces</code> for Faces, <code>m_landmarks</code> for Landmarks and the mask in coordinates
+         * of the original image for the other types. The masks may be kept beyond the callback.
+         */
+        std::function<bool(PreprocessingResultType, const FaceImageQualityPreprocessingResult&)> onPreprocessingResult;
+
+        /**
+         * @brief Invoked for each result of a measure once it is computed; may be empty.
+         * @details Compound measures report each of their components.
+         */
+        std::function<bool(QualityMeasure, const QualityMeasureResult&)> onMeasureResult;
+    };
+
+    /**
+     * @brief Flag by which a caller requests to abort running assessments.
+     * @details The token may be cancelled from any thread. Assessments observing it stop at the next
+     * pre-processing stage or measure and terminate running ONNX Runtime inferences.
+     */
+    class CancellationToken
+    {
+    public:
+        /**
+         * @brief Requests the assessments observing this token to stop.
+         */
+        void cancel() noexcept { m_cancelled.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Checks whether the token has been cancelled.
+         * @return true if \link cancel \endlink has been called.
+         */
+        bool isCancelled() const noexcept { return m_cancelled.load(std::memory_order_relaxed); }
+
+    private:
+        /**
+         * @brief Set by \link cancel \endlink.
+         */
+        std::atomic<bool> m_cancelled{false};
+    };
+
+    /**
+     * @brief Conditions under which an assessment is aborted.
+     * @see \link OFIQ::Interface::vectorQualityWithCancellation Interface::vectorQualityWithCancellation\endlink
+     */
+    struct AssessmentCancellation
+    {
+        /**
+         * @brief Token aborting the assessment when cancelled; may be null.
+         */
+        std::shared_ptr<const CancellationToken> token;
+
+        /**
+         * @brief Point in time at which the assessment is aborted; no deadline by default.
+         */
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    };
+
     /**
      * @brief
      * The interface to FACE QA implementation
@@ -176,6 +253,107 @@ namespace OFIQ
         virtual OFIQ::ReturnStatus vectorQuality(
             const OFIQ::Image& image, OFIQ::FaceImageQualityAssessment& assessments) = 0;
 
+        /**
+         * @brief  This function takes an image and outputs quality information for a subset of the measures.
+         *
+         * @details Only the selected measures among those activated in the configuration are computed;
+         * the preprocessing is restricted to the stages these measures need, e.g., the segmentation networks
+         * are not run if no selected measure depends on them. Allows a single initialized instance to serve
+         * requests for different sets of measures.
+         *
+         * @param[in] image
+         * Single face image
+         *
+         * @param[out] assessments
+         * An ImageQualityAssessments structure receiving the results of the selected measures.
+         *
+         * @param[in] measures
+         * Measures to be computed.
+         *
+         * @return OFIQ::ReturnStatus
+         */
+        virtual OFIQ::ReturnStatus vectorQuality(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::QualityMeasureSelection& measures) = 0;
+
+        /**
+         * @brief  This function takes an image together with pre-processing results computed by the caller
+         * and outputs quality information.
+         *
+         * @details Face detection, landmark extraction and pose estimation are skipped for the results
+         * supplied in <code>preprocessingInput</code>; all other stages are run as by 
+         * \link OFIQ::Interface::vectorQuality vectorQuality\endlink.
+         *
+         * @param[in] image
+         * Single face image
+         *
+         * @param[out] assessments
+         * An ImageQualityAssessments structure.
+         *
+         * @param[in] preprocessingInput
+         * Faces, landmarks and/or pose already computed for the image.
+         *
+         * @return OFIQ::ReturnStatus
+         */
+        virtual OFIQ::ReturnStatus vectorQualityWithPreprocessingInput(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::FaceImageQualityPreprocessingInput& preprocessingInput) = 0;
+
+        /**
+         * @brief  This function takes an image and outputs quality information, reporting
+         * intermediate results while the assessment is running.
+         *
+         * @details Behaves as \link OFIQ::Interface::vectorQuality vectorQuality\endlink, but invokes
+         * the callbacks of <code>progress</code> as pre-processing results and measure results become
+         * available. A callback returning false cancels the rest of the assessment.
+         *
+         * @param[in] image
+         * Single face image
+         *
+         * @param[out] assessments
+         * An ImageQualityAssessments structure.
+         *
+         * @param[in] progress
+         * Callbacks receiving intermediate results.
+         *
+         * @return OFIQ::ReturnStatus; \link OFIQ::ReturnCode::Cancelled ReturnCode::Cancelled\endlink
+         * if a callback cancelled the assessment.
+         */
+        virtual OFIQ::ReturnStatus vectorQualityWithProgress(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::AssessmentProgress& progress) = 0;
+
+        /**
+         * @brief  This function takes an image and outputs quality information unless the
+         * assessment is cancelled or exceeds a deadline.
+         *
+         * @details Behaves as \link OFIQ::Interface::vectorQuality vectorQuality\endlink, but checks
+         * the token and the deadline of <code>cancellation</code> before each pre-processing stage and
+         * each measure and terminates running ONNX Runtime inferences once they are met. Results computed
+         * before are kept; the remaining measures are set to
+         * \link OFIQ::QualityMeasureReturnCode::Skipped QualityMeasureReturnCode::Skipped\endlink.
+         *
+         * @param[in] image
+         * Single face image
+         *
+         * @param[out] assessments
+         * An ImageQualityAssessments structure.
+         *
+         * @param[in] cancellation
+         * Token and deadline aborting the assessment.
+         *
+         * @return OFIQ::ReturnStatus; \link OFIQ::ReturnCode::Cancelled ReturnCode::Cancelled\endlink
+         * if the token was cancelled and \link OFIQ::ReturnCode::DeadlineExceeded ReturnCode::DeadlineExceeded\endlink
+         * if the deadline passed before the assessment was complete.
+         */
+        virtual OFIQ::ReturnStatus vectorQualityWithCancellation(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::AssessmentCancellation& cancellation) = 0;
+
         /**
          * @brief  This function takes an image and outputs quality information.
          * ZmqFork-NOTE: This is an addition of the ZeroMQ/Python fork, as marked by the "ZmqFork".
@@ -235,6 +413,35 @@ namespace OFIQ
             OFIQ::FaceImageQualityPreprocessingResult& preprocessingResult,
             uint32_t resultRequestsMask) = 0;
 
+        /**
+         * @brief Recomputes quality component values from stored native quality scores.
+         *
+         * @details The quality mapping of the current configuration is applied to all
+         * native quality scores in a single pass, without running any pre-processing or
+         * quality assessment. This allows re-calibrating stored results when only the
+         * sigmoid-based quality mappings of the configuration change.
+         *
+         * @param[in] measure
+         * Measure or measure component whose values are recomputed.
+         *
+         * @param[in] rawScores
+         * Stored native quality scores.
+         *
+         * @param[in,out] scalars
+         * Stored quality component values on input, recomputed values on output; must have
+         * the same size as <code>rawScores</code>. Negative values mark results that were
+         * not assessed successfully and are left unchanged.
+         *
+         * @return OFIQ::ReturnStatus
+         * \link OFIQ::ReturnCode::NotImplemented ReturnCode::NotImplemented\endlink if the
+         * measure is not activated or its quality component values are not computed by
+         * a sigmoid-based quality mapping; <code>scalars</code> is not modified in that case.
+         */
+        virtual OFIQ::ReturnStatus rescoreScalars(
+            OFIQ::QualityMeasure measure,
+            const std::vector<double>& rawScores,
+            std::vector<double>& scalars) = 0;
+
         /**
          * @brief
          * Factory method to return a shared pointer to the Interface object.
@@ -31,6 +31,9 @@
 #include "Executor.h"
 #include "ofiq_lib.h"
 #include "NeuronalNetworkContainer.h"
+#include "PreprocessingStore.h"
+#include "ResultCache.h"
+#include "utils.h"
 
  /**
   * @brief Namespace for OFIQ implementations.
@@ -86,6 +89,62 @@ namespace OFIQ_LIB
         OFIQ::ReturnStatus vectorQuality(
             const OFIQ::Image& image, OFIQ::FaceImageQualityAssessment& assessments) override;
 
+        /**
+         * @brief Run the computation of the selected measures among those set in the configuration.
+         * @details The segmentation networks are only run if a selected measure depends on them.
+         * 
+         * @param[in] image Input image.
+         * @param[out] assessments Container to store the resulting scores.
+         * @param[in] measures Measures to be computed.
+         * @return OFIQ::ReturnStatus 
+         */
+        OFIQ::ReturnStatus vectorQuality(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::QualityMeasureSelection& measures) override;
+
+        /**
+         * @brief Run the computation of all measures set in the configuration, reusing
+         * pre-processing results computed by the caller.
+         * 
+         * @param[in] image Input image.
+         * @param[out] assessments Container to store the resulting scores.
+         * @param[in] preprocessingInput Faces, landmarks and/or pose already computed for the image.
+         * @return OFIQ::ReturnStatus 
+         */
+        OFIQ::ReturnStatus vectorQualityWithPreprocessingInput(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::FaceImageQualityPreprocessingInput& preprocessingInput) override;
+
+        /**
+         * @brief Run the computation of all measures set in the configuration, reporting
+         * intermediate results to the callbacks of <code>progress</code>.
+         * 
+         * @param[in] image Input image.
+         * @param[out] assessments Container to store the resulting scores.
+         * @param[in] progress Callbacks receiving intermediate results; may cancel the assessment.
+         * @return OFIQ::ReturnStatus 
+         */
+        OFIQ::ReturnStatus vectorQualityWithProgress(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::AssessmentProgress& progress) override;
+
+        /**
+         * @brief Run the computation of all measures set in the configuration unless the
+         * assessment is cancelled or exceeds the deadline of <code>cancellation</code>.
+         * 
+         * @param[in] image Input image.
+         * @param[out] assessments Container to store the resulting scores.
+         * @param[in] cancellation Token and deadline aborting the assessment.
+         * @return OFIQ::ReturnStatus 
+         */
+        OFIQ::ReturnStatus vectorQualityWithCancellation(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            const OFIQ::AssessmentCancellation& cancellation) override;
+
         /**
          * @brief Run the computation of all measures set in the configuration 
          * and access pre-precessing result.
@@ -105,6 +164,20 @@ namespace OFIQ_LIB
             OFIQ::FaceImageQualityPreprocessingResult& preprocessingResult,
             uint32_t resultRequestsMask = static_cast<int>(OFIQ::PreprocessingResultType::All)) override;
 
+        /**
+         * @brief Recompute quality component values from stored native quality scores
+         * using the quality mappings of the configuration.
+         *
+         * @param[in] measure Measure or measure component whose values are recomputed.
+         * @param[in] rawScores Stored native quality scores.
+         * @param[in,out] scalars Stored quality component values, replaced by the recomputed ones.
+         * @return OFIQ::ReturnStatus
+         */
+        OFIQ::ReturnStatus rescoreScalars(
+            OFIQ::QualityMeasure measure,
+            const std::vector<double>& rawScores,
+            std::vector<double>& scalars) override;
+
         /**
          * @brief Run the computation of all measures set in the configuration.
          * ZmqFork-NOTE: This is an addition of the ZeroMQ/Python fork, as marked by the "ZmqFork".
@@ -138,6 +211,25 @@ namespace OFIQ_LIB
          */
         std::unique_ptr<NeuronalNetworkContainer> networks;
 
+        /**
+         * @brief Cache of assessments of previously seen images; null if disabled, see @ref sec_result_cache_cfg.
+         * 
+         */
+        std::unique_ptr<ResultCache> m_resultCache;
+
+        /**
+         * @brief Store writing or providing pre-processing artifacts; null if disabled,
+         * see @ref sec_preprocessing_store_cfg.
+         * 
+         */
+        std::unique_ptr<PreprocessingStore> m_preprocessingStore;
+
+        /**
+         * @brief Method used to estimate the face alignment transformation, read from the configuration.
+         * 
+         */
+        AlignmentMethod m_alignmentMethod{ AlignmentMethod::LMEDS };
+
         /**
          * @brief Create a Executor object
          * 
@@ -151,14 +243,30 @@ namespace OFIQ_LIB
          */
         void CreateNetworks();
 
+        /**
+         * @brief Stages of the preprocessing.
+         * 
+         */
+        enum class PreprocessingStage
+        {
+            /** Face detection, pose estimation, landmark extraction, alignment and landmarked face region */
+            FaceGeometry,
+            /** Face parsing and face occlusion segmentation; requires the results of FaceGeometry */
+            Segmentations,
+            /** All stages */
+            All
+        };
+
         /**
          * @brief Perform the preprocessing.
          * 
          * @param session Session object containing the original facial image
          * for which the preprocessing will be performed. 
          * The pre-processing results will be stored in the passed Session object.
+         * @param stage Stage of the preprocessing to be performed. The assessment cascade
+         * checks its gates between the stages.
          */
-        OFIQ::ReturnStatus preprocess(Session& session);
+        OFIQ::ReturnStatus preprocess(Session& session, PreprocessingStage stage = PreprocessingStage::All);
         
         /**
          * @brief Perform the assessment.
@@ -169,6 +277,55 @@ namespace OFIQ_LIB
          */
         OFIQ::ReturnStatus performAssessment(Session& session);
 
+        /**
+         * @brief Reports a pre-processing result to the progress callbacks of the session.
+         * @details If a callback receives pre-processing results, the artifact is converted by
+         * \link OFIQ_LIB::OFIQImpl::getPreprocessingResults getPreprocessingResults\endlink and passed to it.
+         * 
+         * @param session Session object whose pre-processing result is reported.
+         * @param type Type of the reported pre-processing result.
+         * @throws OFIQError with the code of \link OFIQ_LIB::Session::cancellationCode Session::cancellationCode\endlink
+         * if the assessment has been cancelled.
+         */
+        void ReportPreprocessingResult(Session& session, OFIQ::PreprocessingResultType type) const;
+
+        /**
+         * @brief Aborts the pre-processing of a cancelled assessment.
+         * 
+         * @param session Session object of the assessment.
+         * @throws OFIQError with the code of \link OFIQ_LIB::Session::cancellationCode Session::cancellationCode\endlink
+         * if the assessment has been cancelled or its deadline has passed.
+         */
+        static void ThrowIfCancelled(const Session& session);
+
+        /**
+         * @brief Completes an assessment cancelled by a progress callback, a cancellation token or a deadline.
+         * @details The results of measures not yet computed are set to
+         * \link OFIQ::QualityMeasureReturnCode::Skipped QualityMeasureReturnCode::Skipped\endlink.
+         * 
+         * @param session Session object of the cancelled assessment.
+         * @return OFIQ::ReturnStatus with the code of \link OFIQ_LIB::Session::cancellationCode Session::cancellationCode\endlink.
+         */
+        OFIQ::ReturnStatus FinishCancelledAssessment(Session& session) const;
+
+        /**
+         * @brief Assesses an image unless its results are found in the result cache.
+         * @details Successful assessments are inserted into the cache. Without cache, the image is
+         * always assessed.
+         * 
+         * @param[in] image Input image.
+         * @param[out] assessments Container to store the resulting scores.
+         * @param[out] preprocessingResult Structure receiving the requested pre-processing results; may be null
+         * if <code>resultRequestsMask</code> is 0.
+         * @param[in] resultRequestsMask Mask encoding the requested pre-processing results.
+         * @return OFIQ::ReturnStatus 
+         */
+        OFIQ::ReturnStatus AssessCached(
+            const OFIQ::Image& image,
+            OFIQ::FaceImageQualityAssessment& assessments,
+            OFIQ::FaceImageQualityPreprocessingResult* preprocessingResult,
+            uint32_t resultRequestsMask);
+
         /**
          * @brief Perform the face alignment.
          * 
@@ -178,6 +335,15 @@ namespace OFIQ_LIB
          */
         void alignFaceImage(Session& session) const;
 
+        /**
+         * @brief Computes the landmarked region of the aligned face.
+         * @details The region depends on <code>params.measures.FaceRegion.alpha</code> and is therefore
+         * recomputed from the aligned landmarks rather than loaded from the pre-processing store.
+         * 
+         * @param session Session object whose aligned face and aligned landmarks have been set
+         */
+        void computeLandmarkedRegion(Session& session) const;
+
         /**
          * @brief Run the computation of all measures set in the configuration.
          * 
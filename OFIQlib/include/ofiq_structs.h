@@ -27,12 +27,15 @@
 #ifndef OFIQ_STRUCTS_H
 #define OFIQ_STRUCTS_H
 
+#include <array>
 #include <cstdint>
 #include <cstring>
+#include <initializer_list>
 #include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -145,7 +148,11 @@ namespace OFIQ
         /** Failure to generate a quality score on the input image */
         QualityAssessmentError,
         /** Function is not implemented */
-        NotImplemented
+        NotImplemented,
+        /** The assessment was cancelled by the caller */
+        Cancelled,
+        /** The deadline of the assessment has passed */
+        DeadlineExceeded
     };
 
     /** Output stream operator for a ReturnCode object. */
@@ -161,6 +168,10 @@ namespace OFIQ
             return (s << "Failure to generate a quality score on the input image");
         case ReturnCode::NotImplemented:
             return (s << "Function is not implemented");
+        case ReturnCode::Cancelled:
+            return (s << "The assessment was cancelled");
+        case ReturnCode::DeadlineExceeded:
+            return (s << "The deadline of the assessment has passed");
         default:
             return (s << "Undefined error");
         }
@@ -288,7 +299,10 @@ namespace OFIQ
         /** Unable to assess a quality measure */
         FailureToAssess,
         /** Quality measure is not initialized */
-        NotInitialized
+        NotInitialized,
+        /** Quality measure was not computed since the image failed a gate of the assessment cascade
+         * or the assessment was cancelled */
+        Skipped
     };
 
     /**
@@ -334,6 +348,231 @@ namespace OFIQ
      */
     using QualityAssessments = std::map<QualityMeasure, QualityMeasureResult>;
 
+    /**
+     * @brief Fixed-layout container of quality measure results indexed by the
+     * \link OFIQ::QualityMeasure QualityMeasure\endlink enum.
+     * @details The results are stored in an array with one slot per measure and a bitmask
+     * marks the slots that have been set. Filling the container does not allocate, copying
+     * it is a plain memory copy, and it can be converted to the 
+     * \link OFIQ::QualityAssessments QualityAssessments\endlink map used by the API.
+     * <br/><br/>
+     * The slot of a measure with enum value v in [0x41, 0x5c] is v - 0x41; the compound measures
+     * \link OFIQ::QualityMeasure::Luminance Luminance\endlink, 
+     * \link OFIQ::QualityMeasure::CropOfTheFaceImage CropOfTheFaceImage\endlink and 
+     * \link OFIQ::QualityMeasure::HeadPose HeadPose\endlink occupy the last three slots.
+     */
+    struct DenseQualityAssessments
+    {
+        /** @brief Number of slots, i.e., of distinct quality measures. */
+        static constexpr size_t Capacity = 31;
+
+        static_assert(Capacity <= 32, "the presence mask holds one bit per slot");
+
+        /** @brief Slot index returned for values that are no quality measure. */
+        static constexpr size_t InvalidIndex = Capacity;
+
+        /**
+         * @brief Returns the slot of a measure.
+         * @param measure Enum value of the measure.
+         * @return Slot in [0, Capacity) or InvalidIndex.
+         */
+        static constexpr size_t IndexOf(QualityMeasure measure)
+        {
+            const auto value = static_cast<int>(measure);
+            if (value >= static_cast<int>(QualityMeasure::UnifiedQualityScore) &&
+                value <= static_cast<int>(QualityMeasure::NoHeadCoverings))
+                return static_cast<size_t>(value - static_cast<int>(QualityMeasure::UnifiedQualityScore));
+            switch (measure)
+            {
+            case QualityMeasure::Luminance:
+                return Capacity - 3;
+            case QualityMeasure::CropOfTheFaceImage:
+                return Capacity - 2;
+            case QualityMeasure::HeadPose:
+                return Capacity - 1;
+            default:
+                return InvalidIndex;
+            }
+        }
+
+        /**
+         * @brief Returns the measure stored in a slot; inverse of IndexOf().
+         * @param index Slot in [0, Capacity).
+         * @return Enum value of the measure.
+         */
+        static constexpr QualityMeasure MeasureAt(size_t index)
+        {
+            if (index == Capacity - 3)
+                return QualityMeasure::Luminance;
+            if (index == Capacity - 2)
+                return QualityMeasure::CropOfTheFaceImage;
+            if (index == Capacity - 1)
+                return QualityMeasure::HeadPose;
+            return static_cast<QualityMeasure>(static_cast<int>(QualityMeasure::UnifiedQualityScore) + static_cast<int>(index));
+        }
+
+        /** @brief Results; only slots marked in presence are valid. */
+        std::array<QualityMeasureResult, Capacity> results;
+
+        /** @brief Bit i is set if slot i holds a result. */
+        uint32_t presence{ 0 };
+
+        /**
+         * @brief Stores the result of a measure; values that are no quality measure are ignored.
+         * @param measure Enum value of the measure.
+         * @param result Result of the measure.
+         */
+        void set(QualityMeasure measure, const QualityMeasureResult& result)
+        {
+            const size_t index = IndexOf(measure);
+            if (index == InvalidIndex)
+                return;
+            results[index] = result;
+            presence |= 1u << index;
+        }
+
+        /**
+         * @brief Checks if a result of a measure is stored.
+         * @param measure Enum value of the measure.
+         * @return true if a result is stored.
+         */
+        bool contains(QualityMeasure measure) const
+        {
+            const size_t index = IndexOf(measure);
+            return index != InvalidIndex && (presence & (1u << index)) != 0;
+        }
+
+        /**
+         * @brief Returns the result of a measure.
+         * @param measure Enum value of the measure.
+         * @return Pointer to the result or nullptr if no result is stored.
+         */
+        const QualityMeasureResult* find(QualityMeasure measure) const
+        {
+            return contains(measure) ? &results[IndexOf(measure)] : nullptr;
+        }
+
+        /** @brief Number of stored results. */
+        size_t size() const
+        {
+            size_t count = 0;
+            for (uint32_t bits = presence; bits != 0; bits &= bits - 1)
+                count++;
+            return count;
+        }
+
+        /** @brief Removes all results. */
+        void clear()
+        {
+            presence = 0;
+            results.fill(QualityMeasureResult());
+        }
+
+        /**
+         * @brief Inserts all stored results into a map, overwriting existing entries of the same measures.
+         * @param[inout] assessments Map receiving the results.
+         */
+        void copyTo(QualityAssessments& assessments) const
+        {
+            for (size_t i = 0; i < Capacity; i++)
+            {
+                if (presence & (1u << i))
+                    assessments[MeasureAt(i)] = results[i];
+            }
+        }
+
+        /**
+         * @brief Converts the stored results to the map representation.
+         * @return Map containing all stored results.
+         */
+        QualityAssessments toMap() const
+        {
+            QualityAssessments assessments;
+            copyTo(assessments);
+            return assessments;
+        }
+
+        /**
+         * @brief Creates the dense representation of a map.
+         * @param assessments Map of results.
+         * @return Dense container holding the results of all quality measures in the map.
+         */
+        static DenseQualityAssessments FromMap(const QualityAssessments& assessments)
+        {
+            DenseQualityAssessments dense;
+            for (const auto& [measure, result] : assessments)
+                dense.set(measure, result);
+            return dense;
+        }
+    };
+
+    /**
+     * @brief Set of quality measures requested for a single assessment.
+     * @details The set is a bit mask over the slots of
+     * \link OFIQ::DenseQualityAssessments DenseQualityAssessments\endlink. Selecting a compound measure
+     * (e.g., \link OFIQ::QualityMeasure::HeadPose HeadPose\endlink) or any of its components selects
+     * the implementation computing all of its components.
+     */
+    struct QualityMeasureSelection
+    {
+        /** @brief Bit i is set if the measure in slot i of DenseQualityAssessments is selected. */
+        uint32_t mask{ 0 };
+
+        /**
+         * @brief Constructs an empty selection.
+         */
+        QualityMeasureSelection() = default;
+
+        /**
+         * @brief Constructs a selection of the listed measures.
+         * @param measures Measures to be selected.
+         */
+        QualityMeasureSelection(std::initializer_list<QualityMeasure> measures)
+        {
+            for (auto measure : measures)
+                add(measure);
+        }
+
+        /**
+         * @brief Selection of all measures.
+         * @return Selection with all bits set.
+         */
+        static QualityMeasureSelection All()
+        {
+            QualityMeasureSelection selection;
+            // shifted in 64 bits since a 32-bit shift by Capacity is undefined for Capacity == 32
+            selection.mask = static_cast<uint32_t>((uint64_t{ 1 } << DenseQualityAssessments::Capacity) - 1u);
+            return selection;
+        }
+
+        /**
+         * @brief Adds a measure to the selection; values that are no quality measure are ignored.
+         * @param measure Enum value of the measure.
+         * @return Reference to this selection.
+         */
+        QualityMeasureSelection& add(QualityMeasure measure)
+        {
+            if (const size_t index = DenseQualityAssessments::IndexOf(measure);
+                index != DenseQualityAssessments::InvalidIndex)
+                mask |= 1u << index;
+            return *this;
+        }
+
+        /**
+         * @brief Checks if a measure is selected.
+         * @param measure Enum value of the measure.
+         * @return true if the measure is selected.
+         */
+        bool contains(QualityMeasure measure) const
+        {
+            const size_t index = DenseQualityAssessments::IndexOf(measure);
+            return index != DenseQualityAssessments::InvalidIndex && (mask & (1u << index)) != 0;
+        }
+
+        /** @brief Checks if no measure is selected. */
+        bool empty() const { return mask == 0; }
+    };
+
     /**
      * @brief Enum describing the different face detector implementations
      * 
@@ -588,6 +827,43 @@ namespace OFIQ
         FaceImageQualityPreprocessingResult() = default;
     };
 
+    /**
+     * @brief Pre-processing results computed by the caller.
+     * @details Results supplied here are stored in the session instead of being computed by the
+     * corresponding networks; only the missing pre-processing stages are run. Note that the landmark
+     * extraction and the pose estimation read the detected faces, so the face detector still runs if
+     * no faces are supplied.
+     */
+    struct FaceImageQualityPreprocessingInput
+    {
+        /**
+         * @brief Faces found on the image; if not empty, the face detection is skipped.
+         * @details The faces are ordered by decreasing area, the largest face is assessed.
+         */
+        std::vector<OFIQ::BoundingBox> m_faces;
+
+        /**
+         * @brief Landmarks of the largest face in image coordinates; if of type
+         * \link OFIQ::LandmarkType::LM_98 LandmarkType::LM_98\endlink, the landmark extraction is skipped.
+         * @details The 98 landmarks must be ordered as those of the ADNet landmark extractor.
+         */
+        FaceLandmarks m_landmarks;
+
+        /**
+         * @brief Head pose in degrees; if set, the pose estimation is skipped.
+         * @details The angles must be stored as by the pose estimator
+         * \link OFIQ_LIB::modules::poseEstimators::HeadPose3DDFAV2 HeadPose3DDFAV2\endlink: the
+         * HeadPose measure derives HeadPosePitch from element 0, HeadPoseYaw from element 1 and
+         * HeadPoseRoll from element 2.
+         */
+        std::optional<std::array<double, 3>> m_pose;
+
+        /**
+         * @brief Default constructor
+         */
+        FaceImageQualityPreprocessingInput() = default;
+    };
+
 }
 
 #endif /* OFIQ_STRUCTS_H */
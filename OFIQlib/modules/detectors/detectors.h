@@ -57,6 +57,20 @@ namespace OFIQ_LIB
          */
         std::vector<OFIQ::BoundingBox> detectFaces(OFIQ_LIB::Session& session);
 
+        /**
+         * @brief Orders faces by decreasing area and stores the largest one as the bounding box of the assessment.
+         * @details Applied to the faces found by \link detectFaces \endlink as well as to faces supplied
+         * by the caller, see \link OFIQ::FaceImageQualityPreprocessingInput FaceImageQualityPreprocessingInput\endlink.
+         *
+         * @param[in] session
+         * Session whose assessment receives the bounding box of the largest face.
+         * @param[in] faces
+         * Faces found on the image of the session.
+         * @return The faces ordered by decreasing area.
+         */
+        static std::vector<OFIQ::BoundingBox> RankFaces(
+            OFIQ_LIB::Session& session, std::vector<OFIQ::BoundingBox> faces);
+
     protected:
         /**
          * @brief This method is to be called in derived classes to perform the detection of one/more faces on the given image.
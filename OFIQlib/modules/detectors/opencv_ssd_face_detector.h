@@ -91,5 +91,44 @@ namespace OFIQ_LIB::modules::detectors
          * 
          */
         double m_minimalRelativeFaceSize;
+
+        /**
+         * @brief If true, the network input is resampled directly from the unpadded image
+         * (see \link CreateBlobWithoutPadding \endlink). This value is read from the configuration file.
+         * @details The warp uses OpenCV's interpolation table instead of the exact coefficients of
+         * cv::resize; input values may differ by one grey level from the padded path.
+         */
+        bool m_fastPreprocessing{false};
+
+        /**
+         * @brief Width and height of the network input.
+         */
+        const int m_inputSize = 300;
+
+        /**
+         * @brief Mean subtracted from the BGR channels of the network input.
+         */
+        const cv::Scalar m_meanBGR{104, 117, 123};
+
+        /**
+         * @brief Network input resampled from the image, reused between images.
+         */
+        cv::Mat m_resampled;
+
+        /**
+         * @brief Network input blob of shape 1 x 3 x 300 x 300, reused between images.
+         */
+        cv::Mat m_blob;
+
+        /**
+         * @brief Creates the network input without materializing the padded image.
+         * @details Resamples the image into \link m_resampled \endlink with the geometry that resizing the
+         * padded image to 300 x 300 would have, treating the padding as a constant zero border. The result is
+         * packed into \link m_blob \endlink in BGR order with the mean subtracted, as cv::dnn::blobFromImage does.
+         * @param image Input image in BGR format.
+         * @param paddingHorizontal Padding added on the left and on the right.
+         * @param paddingVertical Padding added on top and at the bottom.
+         */
+        void CreateBlobWithoutPadding(const cv::Mat& image, int paddingHorizontal, int paddingVertical);
     };
 }
@@ -33,7 +33,12 @@ namespace OFIQ_LIB
     std::vector<OFIQ::BoundingBox>
         FaceDetectorInterface::detectFaces(OFIQ_LIB::Session& session)
     {
-        auto faces = UpdateFaces(session);
+        return RankFaces(session, UpdateFaces(session));
+    }
+
+    std::vector<OFIQ::BoundingBox>
+        FaceDetectorInterface::RankFaces(OFIQ_LIB::Session& session, std::vector<OFIQ::BoundingBox> faces)
+    {
         if (faces.empty())
             return faces;
 
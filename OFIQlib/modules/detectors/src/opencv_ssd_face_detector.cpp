@@ -30,6 +30,7 @@
 #include <opencv2/dnn.hpp>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <array>
 #include <cmath>
 
 using namespace OFIQ;
@@ -48,11 +49,14 @@ namespace OFIQ_LIB::modules::detectors
         const std::string paramConfidenceThreshold = pathPrefix + "confidence_thr";
         const std::string paramPadding = pathPrefix + "padding";
         const std::string paramMinimalRelativeFaceSize = pathPrefix + "min_rel_face_size";
+        const std::string paramFastPreprocessing = pathPrefix + "fast_preprocessing";
 
 
         m_confidenceThreshold = config.GetNumber(paramConfidenceThreshold);
         m_padding = config.GetNumber(paramPadding);
         m_minimalRelativeFaceSize = config.GetNumber(paramMinimalRelativeFaceSize);
+        if (!config.GetBool(paramFastPreprocessing, m_fastPreprocessing))
+            m_fastPreprocessing = false;
         const auto fileNameProtoTxt = config.getDataDir() + "/" + config.GetString(paramPrototxt);
         const auto fileNameCaffeModel =
             config.getDataDir() + "/" + config.GetString(paramCaffemodel);
@@ -79,16 +83,8 @@ namespace OFIQ_LIB::modules::detectors
 
         auto& faceImage = session.image();
 
-        const bool isRGB = faceImage.depth == 24;
-
-        cv::Mat cvImage(
-            faceImage.height,
-            faceImage.width,
-            isRGB ? CV_8UC3 : CV_8UC1,
-            faceImage.data.get());
-
-        if (!isRGB)
-            cv::cvtColor(cvImage, cvImage, cv::COLOR_GRAY2RGB);
+        // shared BGR conversion of the input image; must not be modified
+        cv::Mat cvImage = session.getImageBGR();
 
         int paddingHorizontal = 0;
         int paddingVertical = 0;
@@ -96,20 +92,35 @@ namespace OFIQ_LIB::modules::detectors
         {
             paddingHorizontal = static_cast<int>(faceImage.width * m_padding);
             paddingVertical = static_cast<int>(faceImage.height * m_padding);
-            cv::Mat paddedImage{
-                cvImage.rows + paddingVertical * 2,
-                cvImage.cols + paddingHorizontal * 2,
-                cvImage.type() };
-            cv::copyMakeBorder(cvImage, paddedImage, paddingVertical, paddingVertical, paddingHorizontal, paddingHorizontal, BORDER_CONSTANT);
-            cvImage = paddedImage;
         }
+        // dimension of the (possibly virtual) padded image the detections refer to
+        const int paddedCols = cvImage.cols + paddingHorizontal * 2;
+        const int paddedRows = cvImage.rows + paddingVertical * 2;
 
-        auto meanBGR = Scalar(104, 117, 123);
-        bool doSwapRB = true; // need to swap RB for RGB images
-        bool doCrop = false;
+        Mat blob;
+        if (m_fastPreprocessing)
+        {
+            CreateBlobWithoutPadding(cvImage, paddingHorizontal, paddingVertical);
+            blob = m_blob;
+        }
+        else
+        {
+            if (m_padding > 0)
+            {
+                cv::Mat paddedImage{
+                    paddedRows,
+                    paddedCols,
+                    cvImage.type() };
+                cv::copyMakeBorder(cvImage, paddedImage, paddingVertical, paddingVertical, paddingHorizontal, paddingHorizontal, BORDER_CONSTANT);
+                cvImage = paddedImage;
+            }
 
-        // Create a 4D blob from the image.
-        Mat blob = dnn::blobFromImage(cvImage, 1.0, Size(300, 300), meanBGR, doSwapRB, doCrop);
+            bool doSwapRB = false; // the session provides a BGR image
+            bool doCrop = false;
+
+            // Create a 4D blob from the image.
+            blob = dnn::blobFromImage(cvImage, 1.0, Size(m_inputSize, m_inputSize), m_meanBGR, doSwapRB, doCrop);
+        }
 
         // Run a model.
         m_dnnNet->setInput(blob /*, "", 1.0, mean*/);
@@ -142,10 +153,10 @@ namespace OFIQ_LIB::modules::detectors
                     b < 1 &&
                     r - l > m_minimalRelativeFaceSize)
                 {
-                    auto left = static_cast<int>(round(l * static_cast<float>(cvImage.cols))) - paddingHorizontal;
-                    auto top = static_cast<int>(round(t * static_cast<float>(cvImage.rows))) - paddingVertical;
-                    auto width = static_cast<int>(round((r - l) * static_cast<float>(cvImage.cols)));
-                    auto height = static_cast<int>(round((b - t) * static_cast<float>(cvImage.rows)));
+                    auto left = static_cast<int>(round(l * static_cast<float>(paddedCols))) - paddingHorizontal;
+                    auto top = static_cast<int>(round(t * static_cast<float>(paddedRows))) - paddingVertical;
+                    auto width = static_cast<int>(round((r - l) * static_cast<float>(paddedCols)));
+                    auto height = static_cast<int>(round((b - t) * static_cast<float>(paddedRows)));
                     
                     classIds.push_back((int)(data[i + 1]) - 1); // Skip 0th background class id.
                     confidences.push_back(confidence);
@@ -161,4 +172,45 @@ namespace OFIQ_LIB::modules::detectors
         return faceRects;
     }
 
+    void SSDFaceDetector::CreateBlobWithoutPadding(
+        const cv::Mat& image, int paddingHorizontal, int paddingVertical)
+    {
+        // Map the network input onto the padded image as cv::resize does and
+        // sample the unpadded image; pixels falling into the padding are
+        // synthesized by the constant (zero) border.
+        const double scaleX = static_cast<double>(image.cols + paddingHorizontal * 2) / m_inputSize;
+        const double scaleY = static_cast<double>(image.rows + paddingVertical * 2) / m_inputSize;
+        cv::Matx23d inverseMap(
+            scaleX, 0.0, 0.5 * scaleX - 0.5 - paddingHorizontal,
+            0.0, scaleY, 0.5 * scaleY - 0.5 - paddingVertical);
+        cv::warpAffine(
+            image, m_resampled, inverseMap, cv::Size(m_inputSize, m_inputSize),
+            cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar::all(0));
+
+        if (m_blob.empty())
+        {
+            const std::array<int, 4> blobShape = { 1, 3, m_inputSize, m_inputSize };
+            m_blob.create(4, blobShape.data(), CV_32F);
+        }
+
+        // Pack into BGR planes and subtract the mean.
+        const size_t planeSize = static_cast<size_t>(m_inputSize) * m_inputSize;
+        auto* planeB = m_blob.ptr<float>();
+        auto* planeG = planeB + planeSize;
+        auto* planeR = planeG + planeSize;
+        const auto meanB = static_cast<float>(m_meanBGR[0]);
+        const auto meanG = static_cast<float>(m_meanBGR[1]);
+        const auto meanR = static_cast<float>(m_meanBGR[2]);
+        for (int y = 0; y < m_inputSize; y++)
+        {
+            const auto* pixel = m_resampled.ptr<uchar>(y);
+            const size_t offset = static_cast<size_t>(y) * m_inputSize;
+            for (int x = 0; x < m_inputSize; x++, pixel += 3)
+            {
+                planeB[offset + x] = static_cast<float>(pixel[0]) - meanB;
+                planeG[offset + x] = static_cast<float>(pixel[1]) - meanG;
+                planeR[offset + x] = static_cast<float>(pixel[2]) - meanR;
+            }
+        }
+    }
 }
@@ -28,6 +28,8 @@
 
 #include "ofiq_lib.h"
 #include "PartExtractor.h"
+#include "RoiMask.h"
+#include "Session.h"
 #include <opencv2/opencv.hpp>
 
 /**
@@ -79,6 +81,35 @@ namespace OFIQ_LIB::modules::landmarks
         (const OFIQ::FaceLandmarks& faceLandmarks, const int height, const int width, 
          const float alpha = 0);
 
+        /**
+         * @brief Computes the same mask as \link GetFaceMask \endlink but restricted to the region around the
+         * convex hull.
+         * @details As for the conformance results, the convex hull is rasterized at 224x224 pixels and scaled to
+         * the image with nearest-neighbour interpolation; no full-size image is allocated.
+         * @param faceLandmarks Facial landmarks object
+         * @param height Height of the image the mask refers to
+         * @param width Width of the image the mask refers to
+         * @param alpha Should be 0; different values have only be used for NIST submissions.
+         * @return Mask restricted to its region of interest
+         */
+        static RoiMask GetFaceMaskRoi
+        (const OFIQ::FaceLandmarks& faceLandmarks, const int height, const int width,
+         const float alpha = 0);
+
+        /**
+         * @brief Returns the mask of \link GetFaceMaskRoi \endlink, computing it at most once per session.
+         * @details The mask is cached in the session keyed by the landmarks, the image size and <code>alpha</code>.
+         * @param session Session used as cache.
+         * @param faceLandmarks Facial landmarks object
+         * @param height Height of the image the mask refers to
+         * @param width Width of the image the mask refers to
+         * @param alpha Should be 0; different values have only be used for NIST submissions.
+         * @return Mask restricted to its region of interest. The data is shared with the cache and must not be modified.
+         */
+        static RoiMask GetCachedFaceMask
+        (Session& session, const OFIQ::FaceLandmarks& faceLandmarks, const int height, const int width,
+         const float alpha = 0);
+
         /**
          * @brief Convenience method for computing the Euclidean distance between two landmark points.
          * @param a First landmark point
@@ -103,7 +134,7 @@ namespace OFIQ_LIB::modules::landmarks
          * @param landmarks Facial landmarks
          * @return Center point of the landmarks.
          */
-        static OFIQ::LandmarkPoint GetMiddle(const OFIQ::Landmarks& landmarks);
+        static OFIQ::LandmarkPoint GetMiddle(std::span<const OFIQ::LandmarkPoint> landmarks);
 
         /**
          * @brief Computes the point in between two landmark points.
@@ -112,7 +143,8 @@ namespace OFIQ_LIB::modules::landmarks
          */
         static OFIQ::LandmarkPoint GetMiddle(const LandmarkPair& pair)
         {
-            return GetMiddle(OFIQ::Landmarks{pair.Lower, pair.Upper});
+            const std::array<OFIQ::LandmarkPoint, 2> points{ pair.Lower, pair.Upper };
+            return GetMiddle(points);
         }
 
         /**
@@ -124,7 +156,7 @@ namespace OFIQ_LIB::modules::landmarks
          */
         static OFIQ::LandmarkPoint GetMiddle(const std::vector<LandmarkPair>& pairs)
         {
-            std::vector<OFIQ::LandmarkPoint> points;
+            FacePartPoints points;
             for (auto pair : pairs)
             {
                 points.push_back(GetMiddle(pair));
@@ -27,6 +27,11 @@
 
 #pragma once
 
+#include <array>
+#include <map>
+#include <span>
+#include <vector>
+
  /**
   * @brief Provides implementations of a landmark extractors.
   */
@@ -91,4 +96,14 @@ namespace OFIQ_LIB::modules::landmarks
      * @brief Structure defining pairs of landmark indices. 
      */
     using FacePairMap = std::map<FaceParts, LandmarkIdPairs>;
+
+    /**
+     * @brief Non-owning view on landmark indices of a face part.
+     */
+    using LandmarkIdSpan = std::span<const LandmarkId>;
+
+    /**
+     * @brief Non-owning view on landmark index pairs of a face part.
+     */
+    using LandmarkIdPairSpan = std::span<const LandmarkIdPair>;
 }
\ No newline at end of file
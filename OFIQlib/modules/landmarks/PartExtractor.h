@@ -28,6 +28,9 @@
 
 #include "ofiq_lib.h"
 #include "FaceParts.h"
+#include "OFIQError.h"
+#include <array>
+#include <span>
 
 /**
  * @brief Provides implementations for computations with landmarks. 
@@ -70,6 +73,85 @@ namespace OFIQ_LIB::modules::landmarks
         }
     };
 
+    /**
+     * @brief Landmark points of a face part stored inline without heap allocation.
+     * @details The capacity covers the largest face part (the face contour of ADNet with 33 points).
+     * The points are contiguous, so the container converts implicitly to 
+     * <code>std::span<const OFIQ::LandmarkPoint></code>.
+     */
+    class FacePartPoints
+    {
+    public:
+        /**
+         * @brief Maximal number of landmark points of a face part.
+         */
+        static constexpr size_t capacity = 33;
+
+        /**
+         * @brief Appends a point.
+         * @param point Landmark point.
+         * @throws OFIQError if the capacity is exhausted.
+         */
+        void push_back(const OFIQ::LandmarkPoint& point)
+        {
+            if (m_size >= capacity)
+            {
+                throw OFIQError(
+                    OFIQ::ReturnCode::FaceLandmarkExtractionError,
+                    "Face part exceeds the capacity of " + std::to_string(capacity) + " landmark points");
+            }
+            m_points[m_size++] = point;
+        }
+
+        /**
+         * @brief Number of stored points.
+         * @return Number of points.
+         */
+        size_t size() const { return m_size; }
+
+        /**
+         * @brief Checks if no point is stored.
+         * @return true if empty.
+         */
+        bool empty() const { return m_size == 0; }
+
+        /**
+         * @brief Access to a stored point.
+         * @param index Index in [0, size()).
+         * @return Reference to the point.
+         */
+        const OFIQ::LandmarkPoint& operator[](size_t index) const { return m_points[index]; }
+
+        /**
+         * @brief Iterator to the first point.
+         * @return Pointer to the first point.
+         */
+        const OFIQ::LandmarkPoint* begin() const { return m_points.data(); }
+
+        /**
+         * @brief Iterator past the last point.
+         * @return Pointer past the last point.
+         */
+        const OFIQ::LandmarkPoint* end() const { return m_points.data() + m_size; }
+
+        /**
+         * @brief Pointer to the contiguous storage of the points.
+         * @return Pointer to the first point.
+         */
+        const OFIQ::LandmarkPoint* data() const { return m_points.data(); }
+
+    private:
+        /**
+         * @brief Storage of the points.
+         */
+        std::array<OFIQ::LandmarkPoint, capacity> m_points{};
+
+        /**
+         * @brief Number of stored points.
+         */
+        size_t m_size = 0;
+    };
+
     /**
      * @brief Class that provides helper methods for the administration of landmarks.
      * 
@@ -87,6 +169,32 @@ namespace OFIQ_LIB::modules::landmarks
          */
         static OFIQ::Landmarks getFacePart(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part);
 
+        /**
+         * @brief Returns the indices of the landmarks belonging to the requested face part.
+         * @details The indices are taken from compile-time tables; neither memory is allocated nor a map
+         * is searched.
+         * @param[in] faceLandmarks Landmarks whose type selects the index table.
+         * @param part Face part of interest.
+         * @return View on the landmark indices of the face part.
+         */
+        static LandmarkIdSpan getFacePartIds(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part);
+
+        /**
+         * @brief Same as \link getFacePart \endlink but returning the landmarks in inline storage.
+         * @param[in] faceLandmarks Landmarks to be filtered.
+         * @param part Face part of interest.
+         * @return FacePartPoints Landmarks that belong to the requested face part.
+         */
+        static FacePartPoints getFacePartPoints(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part);
+
+        /**
+         * @brief Returns the index pairs of the landmarks belonging to the requested face part.
+         * @param faceLandmarks Landmarks whose type selects the index table.
+         * @param part Face part of interest.
+         * @return View on the landmark index pairs of the face part.
+         */
+        static LandmarkIdPairSpan getPairIdsForPart(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part);
+
         /**
          * @brief Get LandmarkPairs for a face part.
          * @details LandmarkPairs might be used to compute a distance between upper and lower landmark.
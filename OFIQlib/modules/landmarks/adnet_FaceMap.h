@@ -34,127 +34,156 @@
 
 #include "FaceParts.h"
 #include <array>
-#include <map>
-#include <vector>
+#include <span>
 
 /**
  * @brief Namespace for ADNet-specific landmarks 
  */
 namespace OFIQ_LIB::modules::landmarks::adnet
 {
+    /**
+     * @brief Number of landmarks estimated by ADNet.
+     */
+    inline constexpr size_t numberOfLandmarks = 98;
+
     /**
      * @brief Landmark indices (ADNet) of the left eye.
      * @details The left eye is defined as seen on the image; it is actually the person's right eye (physically).
      */
-    const LandmarkIds leftEye{60,61,62,63,64,65,66,67};
+    inline constexpr std::array<LandmarkId, 8> leftEye{60,61,62,63,64,65,66,67};
 
     /**
      * @brief Landmark indices (ADNet) of the right eye.
      * @details The right eye is defined as seen on the image; it is actually the person's left eye (physically).
      */
-    const LandmarkIds rightEye{68,69,70,71,72,73,74,75};
+    inline constexpr std::array<LandmarkId, 8> rightEye{68,69,70,71,72,73,74,75};
 
     /**
      * @brief Landmark indices (ADNet) of the left eyes' corners. 
      */
-    const LandmarkIds leftEyeCorners{60,64};
+    inline constexpr std::array<LandmarkId, 2> leftEyeCorners{60,64};
 
     /**
      * @brief Landmark indices (ADNet) of the right eyes' corners.
      */
-    const LandmarkIds rightEyeCorners{68,72};
+    inline constexpr std::array<LandmarkId, 2> rightEyeCorners{68,72};
 
     /**
      *  @brief Landmark index (ADNet) of the nose tip.
      */
-    const LandmarkIds nosetip{54};
+    inline constexpr std::array<LandmarkId, 1> nosetip{54};
 
     /**
      * @brief Landmark indices (ADNet) on the mouth's outer contour. 
      */
-    const LandmarkIds mouthOuter{76,77,78,79,80,81,82,83,84,85,86,87};
+    inline constexpr std::array<LandmarkId, 12> mouthOuter{76,77,78,79,80,81,82,83,84,85,86,87};
     
     /**
      * @brief Landmark indices (ADNet) on the mouth's inner lip borders.
      */
-    const LandmarkIds mouthInner{88,89,90,91,92,93,94,95};
+    inline constexpr std::array<LandmarkId, 8> mouthInner{88,89,90,91,92,93,94,95};
     
     /**
      * @brief Landmark indices (ADNet) of the face contour. 
      */
-    const LandmarkIds contour{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32};
-
-    /**
-     * @brief Landmark indices (ADNet) of the forehead (empty for ADNet).
-     */
-    const LandmarkIds forehead{};
+    inline constexpr std::array<LandmarkId, 33> contour{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32};
 
     /**
      * @brief Landmark index (ADNet) of the chin. 
      */
-    const LandmarkIds chin{16};
-
-    /**
-     * @brief ADNets face map definition. 
-     */
-    const landmarks::FaceMap FaceMap{
-        {FaceParts::LEFT_EYE,          leftEye       },
-        {FaceParts::RIGHT_EYE,         rightEye      },
-        {FaceParts::LEFT_EYE_CORNERS,  leftEyeCorners},
-        {FaceParts::RIGHT_EYE_CORNERS, rightEyeCorners},
-        {FaceParts::MOUTH_OUTER,       mouthOuter    },
-        {FaceParts::MOUTH_INNER,       mouthInner    },
-        {FaceParts::FACE_CONTOUR,      contour       },
-        {FaceParts::CHIN,              chin          },
-        {FaceParts::NOSETIP,           nosetip       },
-        {FaceParts::FOREHEAD,          forehead      }
-    };
+    inline constexpr std::array<LandmarkId, 1> chin{16};
+
+    /**
+     * @brief ADNets face map definition.
+     * @details Returns a view on the compile-time index table of the requested face part; 
+     * the forehead and the mouth center are not defined by single landmarks and yield an empty view.
+     * @param part Face part of interest.
+     * @return Landmark indices of the face part.
+     */
+    constexpr LandmarkIdSpan FacePart(FaceParts part)
+    {
+        switch (part)
+        {
+        case FaceParts::LEFT_EYE:
+            return leftEye;
+        case FaceParts::RIGHT_EYE:
+            return rightEye;
+        case FaceParts::LEFT_EYE_CORNERS:
+            return leftEyeCorners;
+        case FaceParts::RIGHT_EYE_CORNERS:
+            return rightEyeCorners;
+        case FaceParts::MOUTH_OUTER:
+            return mouthOuter;
+        case FaceParts::MOUTH_INNER:
+            return mouthInner;
+        case FaceParts::FACE_CONTOUR:
+            return contour;
+        case FaceParts::CHIN:
+            return chin;
+        case FaceParts::NOSETIP:
+            return nosetip;
+        default:
+            return {};
+        }
+    }
 
     /**
      * @brief Pair indices of landmarks (ADNet) for the left eye.
      * @details Useful to measure eye openess.
      */
-    const LandmarkIdPairs pairsLeftEye{
+    inline constexpr std::array<LandmarkIdPair, 3> pairsLeftEye{{
         {61, 67},
         {62, 66},
         {63, 65}
-    };
+    }};
 
     /**
      * @brief Landmark index pairs (ADNet) of landmarks for the right eye.
      * @details Useful to measure eye openess.
      */
-    const LandmarkIdPairs pairsRightEye{
+    inline constexpr std::array<LandmarkIdPair, 3> pairsRightEye{{
         {69, 75},
         {70, 74},
         {71, 73}
-    };
+    }};
 
     /**
      * @brief Landmark index pairs (ADNet) of inner lip pairs.
      * @details Useful to measure closedness of mouth.
      */
-    const LandmarkIdPairs pairsInnerLip{
+    inline constexpr std::array<LandmarkIdPair, 3> pairsInnerLip{{
         {89, 95},
         {90, 94},
         {91, 93}
-    };
+    }};
 
     /**
      * @brief Landmark index pair (ADNet) of the inner mouth (lips) center. 
      * @details Useful to measure closedness of mouth.
      */
-    const LandmarkIdPairs pairsMouthCenter{
+    inline constexpr std::array<LandmarkIdPair, 1> pairsMouthCenter{{
         {90, 94}
-    };
+    }};
 
     /**
      * @brief ADNets face pair map definition.
-     */
-    const landmarks::FacePairMap FacePairMap{
-        {FaceParts::LEFT_EYE,     pairsLeftEye    },
-        {FaceParts::RIGHT_EYE,    pairsRightEye   },
-        {FaceParts::MOUTH_INNER,  pairsInnerLip   },
-        {FaceParts::MOUTH_CENTER, pairsMouthCenter}
-    };
-}
\ No newline at end of file
+     * @param part Face part of interest.
+     * @return Landmark index pairs of the face part; empty if no pairs are defined for the part.
+     */
+    constexpr LandmarkIdPairSpan FacePairs(FaceParts part)
+    {
+        switch (part)
+        {
+        case FaceParts::LEFT_EYE:
+            return pairsLeftEye;
+        case FaceParts::RIGHT_EYE:
+            return pairsRightEye;
+        case FaceParts::MOUTH_INNER:
+            return pairsInnerLip;
+        case FaceParts::MOUTH_CENTER:
+            return pairsMouthCenter;
+        default:
+            return {};
+        }
+    }
+}
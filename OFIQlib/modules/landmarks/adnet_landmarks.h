@@ -28,6 +28,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "Configuration.h"
 #include "detectors.h"
 #include "landmarks.h"
@@ -60,6 +61,24 @@ namespace OFIQ_LIB::modules::landmarks
          */
         ~ADNetFaceLandmarkExtractor() override;
 
+        /**
+         * @brief Returns the region of the image cropped as input of ADNet.
+         * @details The crop is resized to the square network input, so the face box is squared
+         * regardless of the detector; boxes supplied by the caller need not be square.
+         * @param face Face box the landmarks are computed for.
+         * @return Square bounding box.
+         */
+        static OFIQ::BoundingBox GetCropBox(const OFIQ::BoundingBox& face);
+
+        /**
+         * @brief Maps landmarks computed on the 256x256 network input to image coordinates.
+         * @param netLandmarks Interleaved x and y coordinates on the network input.
+         * @param cropBox Cropped region as returned by \link GetCropBox \endlink.
+         * @return Landmarks in coordinates of the image.
+         */
+        static OFIQ::FaceLandmarks MapToImage(
+            const std::vector<float>& netLandmarks, const OFIQ::BoundingBox& cropBox);
+
     protected:
         /**
          * @brief Computes landmarks of the face detected in the session.
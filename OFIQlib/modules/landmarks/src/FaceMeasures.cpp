@@ -35,7 +35,7 @@
 
 namespace OFIQ_LIB::modules::landmarks
 {
-    OFIQ::LandmarkPoint FaceMeasures::GetMiddle(const OFIQ::Landmarks& landmarks)
+    OFIQ::LandmarkPoint FaceMeasures::GetMiddle(std::span<const OFIQ::LandmarkPoint> landmarks)
     {
         int32_t sumX = 0;
         int32_t sumY = 0;
@@ -71,9 +71,9 @@ namespace OFIQ_LIB::modules::landmarks
     double FaceMeasures::InterEyeDistance(const OFIQ::FaceLandmarks& faceLandmarks, double yaw)
     {
         const static double EPS = 1e-6;
-        auto leftEyePoints = PartExtractor::getFacePart(faceLandmarks, FaceParts::LEFT_EYE_CORNERS);
+        auto leftEyePoints = PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::LEFT_EYE_CORNERS);
         auto rightEyePoints =
-            PartExtractor::getFacePart(faceLandmarks, FaceParts::RIGHT_EYE_CORNERS);
+            PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::RIGHT_EYE_CORNERS);
 
         auto leftCenter = GetMiddle(leftEyePoints);
         auto rightCenter = GetMiddle(rightEyePoints);
@@ -93,7 +93,7 @@ namespace OFIQ_LIB::modules::landmarks
     }
 
 
-    cv::Mat FaceMeasures::GetFaceMask(
+    RoiMask FaceMeasures::GetFaceMaskRoi(
         const OFIQ::FaceLandmarks& faceLandmarks, const int height, const int width, const float alpha)
     {
         std::vector<cv::Point2i> landmarkPoints;
@@ -107,9 +107,9 @@ namespace OFIQ_LIB::modules::landmarks
             std::vector<cv::Point2i> contour;
             cv::Point2f eyesMidpoint;
             cv::Point2f chin;
-            OFIQ::Landmarks eyeCorners = PartExtractor::getFacePart(faceLandmarks, FaceParts::LEFT_EYE_CORNERS);
-            OFIQ::Landmarks rightEyeCorners = PartExtractor::getFacePart(faceLandmarks, FaceParts::RIGHT_EYE_CORNERS);
-            eyeCorners.insert(eyeCorners.end(), rightEyeCorners.begin(), rightEyeCorners.end());
+            FacePartPoints eyeCorners = PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::LEFT_EYE_CORNERS);
+            for (auto eyeCorner : PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::RIGHT_EYE_CORNERS))
+                eyeCorners.push_back(eyeCorner);
             for (auto eyeCorner : eyeCorners)
             {
                 eyesMidpoint += cv::Point2f(eyeCorner.x, eyeCorner.y);
@@ -169,40 +169,32 @@ namespace OFIQ_LIB::modules::landmarks
         cv::Mat mask = cv::Mat::zeros(cv::Size(imgSize, imgSize), CV_8UC1);
 
         cv::fillConvexPoly(mask, hullPoints, cv::Scalar(1));
-        cv::Mat faceRegion = cv::Mat::zeros(cv::Size(width, height), CV_8UC1);
         cv::Mat maskRescaled;
         cv::resize(mask, maskRescaled, cv::Size(c - a, d - b), 0, 0, cv::INTER_NEAREST);
-        int left = 0;
-        int top = 0;
-        int right = maskRescaled.cols;
-        int bottom = maskRescaled.rows;
-        int an = a;
-        int bn = b;
-        int cn = c;
-        int dn = d;
-        if (a < 0)
-        {
-            left -= a;
-            an = 0;
-        }
-        if (c > width)
-        {
-            right = maskRescaled.cols - (c - width);
-            cn = width;
-        }
-        if (b < 0)
-        {
-            top -= b;
-            bn = 0;
-        }
-        if (d > height)
+        // keep the part of the rescaled crop inside the image instead of copying it into a full-size image
+        const cv::Rect crop(a, b, c - a, d - b);
+        const cv::Rect region = crop & cv::Rect(0, 0, width, height);
+        if (region.empty())
+            return RoiMask(cv::Size(width, height), region);
+        return RoiMask(cv::Size(width, height), region, maskRescaled(region - crop.tl()).clone());
+    }
+
+    cv::Mat FaceMeasures::GetFaceMask(
+        const OFIQ::FaceLandmarks& faceLandmarks, const int height, const int width, const float alpha)
+    {
+        return GetFaceMaskRoi(faceLandmarks, height, width, alpha).toMat();
+    }
+
+    RoiMask FaceMeasures::GetCachedFaceMask(
+        Session& session, const OFIQ::FaceLandmarks& faceLandmarks, const int height, const int width, const float alpha)
+    {
+        RoiMask mask;
+        if (!session.findFaceMask(faceLandmarks, cv::Size(width, height), alpha, mask))
         {
-            bottom = maskRescaled.rows - (d - height);
-            dn = height;
+            mask = GetFaceMaskRoi(faceLandmarks, height, width, alpha);
+            session.storeFaceMask(faceLandmarks, cv::Size(width, height), alpha, mask);
         }
-        cv::Mat crop = maskRescaled(cv::Range(top, bottom), cv::Range(left, right));
-        crop.copyTo(faceRegion(cv::Range(bn, dn), cv::Range(an, cn)));
-        return faceRegion;
+        return mask;
     }
 
     double FaceMeasures::GetMaxPairDistance(
@@ -210,11 +202,10 @@ namespace OFIQ_LIB::modules::landmarks
     {
         double maxDistance = 0;
 
-        auto pairs = landmarks::PartExtractor::getPairsForPart(landmarks, facePart);
-
-        for (auto pair : pairs)
+        for (const auto& pair : landmarks::PartExtractor::getPairIdsForPart(landmarks, facePart))
         {
-            auto distance = landmarks::FaceMeasures::GetDistance(pair);
+            auto distance = landmarks::FaceMeasures::GetDistance(
+                landmarks.landmarks[pair[1]], landmarks.landmarks[pair[0]]);
             maxDistance = std::max(maxDistance, distance);
         }
 
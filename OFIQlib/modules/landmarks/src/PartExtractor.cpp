@@ -26,53 +26,63 @@
 
 #include "PartExtractor.h"
 #include "adnet_FaceMap.h"
+#include <stdexcept>
 
 namespace OFIQ_LIB::modules::landmarks
 {
+    static_assert(adnet::contour.size() <= FacePartPoints::capacity, "the face contour must fit into FacePartPoints");
+
+    LandmarkIdSpan
+        PartExtractor::getFacePartIds(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part)
+    {
+        if (faceLandmarks.type == OFIQ::LandmarkType::LM_98)
+            return adnet::FacePart(part);
+        throw std::invalid_argument("Unknown LandmarkType");
+    }
+
+    LandmarkIdPairSpan
+        PartExtractor::getPairIdsForPart(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part)
+    {
+        if (faceLandmarks.type == OFIQ::LandmarkType::LM_98)
+            return adnet::FacePairs(part);
+        throw std::invalid_argument("Unknown LandmarkType");
+    }
+
     OFIQ::Landmarks
         PartExtractor::getFacePart(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part)
     {
-        const FaceMap* FaceMap;
+        const auto ids = getFacePartIds(faceLandmarks, part);
         OFIQ::Landmarks selectedLandmarks;
-
-        if(faceLandmarks.type == OFIQ::LandmarkType::LM_98)
-            FaceMap = &adnet::FaceMap;
-        else
-            throw std::invalid_argument("Unknown LandmarkType");
-
-        if (auto iterator = FaceMap->find(part); iterator != FaceMap->end())
+        selectedLandmarks.reserve(ids.size());
+        for (const auto& index : ids)
         {
-            const auto& list = iterator->second;
-            for (const auto& index : list)
-            {
-                selectedLandmarks.push_back(faceLandmarks.landmarks[index]);
-            }
+            selectedLandmarks.push_back(faceLandmarks.landmarks[index]);
         }
+        return selectedLandmarks;
+    }
 
+    FacePartPoints
+        PartExtractor::getFacePartPoints(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part)
+    {
+        FacePartPoints selectedLandmarks;
+        for (const auto& index : getFacePartIds(faceLandmarks, part))
+        {
+            selectedLandmarks.push_back(faceLandmarks.landmarks[index]);
+        }
         return selectedLandmarks;
     }
 
     std::vector<LandmarkPair>
         PartExtractor::getPairsForPart(const OFIQ::FaceLandmarks& faceLandmarks, FaceParts part)
     {
-        const FacePairMap* FacePairMap;
+        const auto ids = getPairIdsForPart(faceLandmarks, part);
         std::vector<LandmarkPair> selectedLandmarkPairs;
-
-        if (faceLandmarks.type == OFIQ::LandmarkType::LM_98)
-            FacePairMap = &adnet::FacePairMap;
-        else
-            throw std::invalid_argument("Unknown LandmarkType");
-
-        if (auto iterator = FacePairMap->find(part); iterator != FacePairMap->end())
+        selectedLandmarkPairs.reserve(ids.size());
+        for (const auto& index : ids)
         {
-            const auto& list = iterator->second;
-            for (const auto& index : list)
-            {
-                selectedLandmarkPairs.push_back(
-                    {faceLandmarks.landmarks[index[0]], faceLandmarks.landmarks[index[1]]});
-            }
+            selectedLandmarkPairs.push_back(
+                {faceLandmarks.landmarks[index[0]], faceLandmarks.landmarks[index[1]]});
         }
-
         return selectedLandmarkPairs;
     }
-}
\ No newline at end of file
+}
@@ -26,6 +26,7 @@
 
 #include "adnet_landmarks.h"
 #include "OFIQError.h"
+#include "Interruption.h"
 #include "utils.h"
 
 #include <algorithm>
@@ -53,13 +54,9 @@ namespace OFIQ_LIB::modules::landmarks
             // scale image
             cv::Mat scaled_image = scale_image_to_inputsize(i_input_image);
             // convert to input for the net
-            std::vector<float> net_input = convert_to_net_input(scaled_image);
-            if (net_input.size() != m_number_of_input_elements)
-            {
-                throw OFIQError(ReturnCode::FaceLandmarkExtractionError, "invalid image format.");
-            }
+            convert_to_net_input(scaled_image, m_net_input);
 
-            std::vector<float> landmarks_from_net = find_landmarks(net_input);
+            std::vector<float> landmarks_from_net = find_landmarks(m_net_input);
 
             return landmarks_from_net;
         }
@@ -82,26 +79,17 @@ namespace OFIQ_LIB::modules::landmarks
         }
 
     private:
-        std::vector<float> convert_to_net_input(const cv::Mat& i_input_image) const
+        void convert_to_net_input(const cv::Mat& i_input_image, std::vector<float>& o_net_input) const
         {
-            // reshape to 1D
-            auto image = i_input_image.reshape(1, 1);
-
-            // Normalize and Convert to vector<float> from cv::Mat.
-            std::vector<float> vec;
-            image.convertTo(vec, CV_32FC1, 2. / 255, -1.);
-
-            // Transpose Height, Width, Channel to Channel, Height, Width
-            std::vector<float> output;
-            for (size_t ch = 0; ch < 3; ++ch)
+            if (i_input_image.type() != CV_8UC3 ||
+                static_cast<int64_t>(i_input_image.total()) * 3 != m_number_of_input_elements)
             {
-                for (size_t i = ch; i < vec.size(); i += 3)
-                {
-                    output.emplace_back(vec[i]);
-                }
+                throw OFIQError(ReturnCode::FaceLandmarkExtractionError, "invalid image format.");
             }
 
-            return output;
+            // Normalize to [-1, 1] and transpose Height, Width, Channel to Channel, Height, Width
+            o_net_input.resize(m_number_of_input_elements);
+            packPlanarNormalized(i_input_image, 2.0f / 255, -1.0f, o_net_input.data());
         }
 
         cv::Mat scale_image_to_inputsize(const cv::Mat& i_input_image) const
@@ -187,6 +175,7 @@ namespace OFIQ_LIB::modules::landmarks
             try
             {
                 Ort::RunOptions runOptions;
+                Interruption::ScopedRun scopedRun(runOptions);
                 auto results = m_ort_session->Run(
                     runOptions,
                     inputNames.data(),
@@ -228,6 +217,9 @@ namespace OFIQ_LIB::modules::landmarks
         int64_t m_expected_image_height = 0;
         int64_t m_expected_image_number_of_channels = 0;
         int64_t m_number_of_input_elements = 0;
+
+        // reused input buffer of the net
+        std::vector<float> m_net_input;
     };
 
     //--------------------------------------------------
@@ -261,6 +253,36 @@ namespace OFIQ_LIB::modules::landmarks
 
     ADNetFaceLandmarkExtractor::~ADNetFaceLandmarkExtractor() = default;
 
+    OFIQ::BoundingBox ADNetFaceLandmarkExtractor::GetCropBox(const OFIQ::BoundingBox& face)
+    {
+        // SSD boxes do not have to be quadratic and neither do boxes supplied by the caller
+        return OFIQ_LIB::makeSquareBoundingBox(face);
+    }
+
+    OFIQ::FaceLandmarks ADNetFaceLandmarkExtractor::MapToImage(
+        const std::vector<float>& netLandmarks, const OFIQ::BoundingBox& cropBox)
+    {
+        OFIQ::FaceLandmarks landmarks;
+        float scalingFactor = cropBox.height / 256.0f;
+
+        int offset_x = cropBox.xleft;
+        int offset_y = cropBox.ytop;
+        landmarks.landmarks.reserve(netLandmarks.size() / 2);
+        for (int i = 0; i + 1 < netLandmarks.size(); i += 2)
+        {
+            auto x = static_cast<int>(
+                std::round(netLandmarks[i] * scalingFactor+static_cast<float>(offset_x)));
+            auto y = static_cast<int>(
+                std::round(netLandmarks[i+1] * scalingFactor+static_cast<float>(offset_y)));
+            landmarks.landmarks.emplace_back(
+                LandmarkPoint(static_cast<uint16_t>(x), static_cast<uint16_t>(y)));
+        }
+
+        landmarks.type = LandmarkType::LM_98;
+
+        return landmarks;
+    }
+
     OFIQ::FaceLandmarks ADNetFaceLandmarkExtractor::updateLandmarks(Session& session)
     {
         OFIQ::FaceLandmarks landmarks;
@@ -281,57 +303,16 @@ namespace OFIQ_LIB::modules::landmarks
         }
 
         const size_t faceIndex = 0; // take largest face found
-        OFIQ::BoundingBox detectedFace = faceRects[faceIndex];
-
-        cv::Mat cvImage = copyToCvImage(session.image());
-        Point2i translationVector{ 0, 0 };
-
-        if (detectedFace.faceDetector == FaceDetectorType::OPENCVSSD) {
-            // SSD bounding box does not have to be quadratic -> check and make it square
-            cv::Mat cvImage_maybe_padded;
-            OFIQ::BoundingBox detectedFaceSquare;
-            
-            OFIQ_LIB::makeSquareBoundingBoxWithPadding(
-                detectedFace,
-                cvImage,
-                cvImage_maybe_padded,
-                detectedFaceSquare,
-                translationVector
-            );
-            cvImage = cvImage_maybe_padded;
-            detectedFace = detectedFaceSquare;
-
-        } // if opencvssd
-
-        // crop image
-        // Define the region of interest (ROI) for cropping
-        cv::Rect roi(
-            detectedFace.xleft,
-            detectedFace.ytop,
-            detectedFace.width,
-            detectedFace.height); // (x, y, width, height)
-
-        // Crop the image using the ROI
-        cv::Mat croppedImage = cvImage(roi);
-        if (!croppedImage.isContinuous())
-            croppedImage = croppedImage.clone();
+        const OFIQ::BoundingBox cropBox = GetCropBox(faceRects[faceIndex]);
 
-        std::vector<float> landmarks_from_net = landmarkExtractor_->extractLandMarks(croppedImage);
-        float scalingFactor = detectedFace.height / 256.0f;
+        const cv::Mat& cvImage = session.getImageBGR();
 
-        int offset_x = detectedFace.xleft - translationVector.x;
-        int offset_y = detectedFace.ytop - translationVector.y;
-        for (int i = 0; i < landmarks_from_net.size(); i += 2)
-        {
-            auto x = static_cast<int>(
-                std::round(landmarks_from_net[i] * scalingFactor+static_cast<float>(offset_x)));
-            auto y = static_cast<int>(
-                std::round(landmarks_from_net[i+1] * scalingFactor+static_cast<float>(offset_y)));
-            landmarks.landmarks.emplace_back(
-                LandmarkPoint(static_cast<uint16_t>(x), static_cast<uint16_t>(y)));
-        }
+        // crop image; parts of the bounding box outside the image are filled with black
+        cv::Mat croppedImage = OFIQ_LIB::cropWithConstantBorder(cvImage, cropBox);
+        if (!croppedImage.isContinuous())
+            croppedImage = croppedImage.clone();
 
-        landmarks.type = LandmarkType::LM_98;
+        landmarks = MapToImage(landmarkExtractor_->extractLandMarks(croppedImage), cropBox);
 
         return landmarks;
     }
@@ -99,5 +99,11 @@ namespace OFIQ_LIB::modules::measures
          * @brief Manages CNN estimations. 
          */
         ONNXRuntimeSegmentation m_onnxRuntimeEnv;
+
+        /**
+         * @brief If true, the network input is sampled directly from the input image,
+         * see \link OFIQ_LIB::GeometryPlan GeometryPlan\endlink.
+         */
+        bool m_directWarp{false};
     };
 }
\ No newline at end of file
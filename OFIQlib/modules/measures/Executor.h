@@ -45,6 +45,25 @@ namespace OFIQ_LIB::modules::measures
      */
     void log(const std::string_view& msg);
 
+    /**
+     * @brief Gate of the assessment cascade.
+     * @details An image passes the gate if the result of the gate measure has been computed
+     * successfully and its scalar value is at least the configured minimum.
+     */
+    struct CascadeGate
+    {
+        /**
+         * @brief Measure whose result is checked. For the compound measures, the results
+         * of all their components are checked.
+         */
+        OFIQ::QualityMeasure measure;
+
+        /**
+         * @brief Minimum scalar value required to pass the gate.
+         */
+        double minimumScalar;
+    };
+
     /**
      * @brief This class takes care of the computation of the measures activated.
      */
@@ -63,11 +82,74 @@ namespace OFIQ_LIB::modules::measures
 
         /**
          * @brief Run the computation of the activated measures on the data of the provided session.
+         * @details Measures not selected in the session are not executed.
          * 
          * @param i_currentSession Container providing the data required for the computation of the measures.
          */
         void ExecuteAll(Session & i_currentSession) const;
 
+        /**
+         * @brief Sets the gates of the assessment cascade.
+         * @details The measures computing the gates are moved to the front of the activated measures
+         * in the order of the gates. A measure is executed only once even if several gates refer to it.
+         * 
+         * @param gates Ordered list of gates; an empty list disables the cascade.
+         * @throws OFIQError if a gate refers to a measure that is not activated or that
+         * depends on a segmentation (see \link RequiresSegmentation \endlink).
+         */
+        void SetCascade(const std::vector<CascadeGate>& gates);
+
+        /**
+         * @brief Checks whether gates of the assessment cascade are set.
+         * @return true if at least one gate is set.
+         */
+        bool HasCascade() const { return !m_gates.empty(); }
+
+        /**
+         * @brief Executes the measures of the gates one after another and checks the gates.
+         * @details Stops at the first gate that is not passed; the measures of the remaining gates are not executed.
+         * 
+         * @param i_currentSession Container providing the data required for the computation of the measures.
+         * @return true if all gates are passed; false if a gate is not passed or the session is cancelled.
+         */
+        bool ExecuteGates(Session & i_currentSession) const;
+
+        /**
+         * @brief Executes the activated measures not executed by \link ExecuteGates \endlink.
+         * 
+         * @param i_currentSession Container providing the data required for the computation of the measures.
+         */
+        void ExecuteRemaining(Session & i_currentSession) const;
+
+        /**
+         * @brief Sets the result of all activated measures (or their components) that have no result yet.
+         * 
+         * @param i_currentSession Session whose results are completed.
+         * @param code Return code of the results; the scalar values are set to -1.
+         */
+        void SetMissingResults(Session & i_currentSession, OFIQ::QualityMeasureReturnCode code) const;
+
+        /**
+         * @brief Checks whether a measure selected in the session depends on a segmentation.
+         * 
+         * @param i_currentSession Session providing the measure selection, see
+         * \link OFIQ_LIB::Session::measureSelection() Session::measureSelection()\endlink.
+         * @return true if the segmentation networks have to be run for the selected measures.
+         */
+        bool RequiresSegmentations(const Session & i_currentSession) const;
+
+        /**
+         * @brief Recomputes quality component values of a measure from stored native quality scores.
+         * @details The call is forwarded to the activated measure implementing <code>measure</code>, see
+         * \link OFIQ_LIB::modules::measures::Measure::RescoreScalars() Measure::RescoreScalars()\endlink.
+         * @param measure Enum value of the measure or measure component.
+         * @param rawScores Native quality scores.
+         * @param scalars Stored quality component values on input, recomputed values on output.
+         * @return false if the measure is not activated or its quality component values are
+         * not computed by a sigmoid-based quality mapping.
+         */
+        bool RescoreScalars(OFIQ::QualityMeasure measure, const std::vector<double>& rawScores, std::vector<double>& scalars) const;
+
         /**
          * @brief Return the list of the activated measures.
          *
@@ -80,5 +162,61 @@ namespace OFIQ_LIB::modules::measures
          * 
          */
         std::vector<std::unique_ptr<Measure>> m_measures;
+
+        /**
+         * @brief Gates of the assessment cascade, see \link SetCascade \endlink.
+         * 
+         */
+        std::vector<CascadeGate> m_gates;
+
+        /**
+         * @brief For each gate, the number of leading measures that have to be executed before checking it.
+         * 
+         */
+        std::vector<size_t> m_gateMeasureCounts;
+
+        /**
+         * @brief Number of leading measures executed by \link ExecuteGates \endlink.
+         * 
+         */
+        size_t m_numberOfGateMeasures = 0;
+
+        /**
+         * @brief Executes the measures in the range <code>[begin, end)</code>.
+         * @details The results of each measure are reported to the progress callbacks of the session;
+         * execution stops once the session is cancelled.
+         * 
+         * @param i_currentSession Container providing the data required for the computation of the measures.
+         * @param begin Index of the first measure.
+         * @param end Index after the last measure.
+         */
+        void Execute(Session & i_currentSession, size_t begin, size_t end) const;
+
+        /**
+         * @brief Checks whether the results in the session pass a gate.
+         * 
+         * @param i_currentSession Session containing the results of the gate measure.
+         * @param gate Gate to be checked.
+         * @return true if the gate is passed.
+         */
+        static bool PassesGate(const Session & i_currentSession, const CascadeGate& gate);
+
+        /**
+         * @brief Reports the results of a measure to the progress callbacks of the session.
+         * 
+         * @param i_currentSession Session containing the results of the measure.
+         * @param implementation Enum value returned by \link Measure::GetQualityMeasure() \endlink.
+         */
+        static void ReportResults(Session & i_currentSession, OFIQ::QualityMeasure implementation);
+
+        /**
+         * @brief Checks whether the implementation of a measure is selected in the session.
+         * @details The implementation is selected if the measure itself or one of its components is selected.
+         * 
+         * @param i_currentSession Session providing the measure selection.
+         * @param implementation Enum value returned by \link Measure::GetQualityMeasure() \endlink.
+         * @return true if the measure has to be executed.
+         */
+        static bool IsSelected(const Session & i_currentSession, OFIQ::QualityMeasure implementation);
     };
 }
\ No newline at end of file
@@ -62,6 +62,13 @@ namespace OFIQ_LIB::modules::measures
         void Execute(OFIQ_LIB::Session& session) override;
 
     private:
+        /**
+         * @brief Converts a BGR image to RGB and normalizes it by the ImageNet mean and standard deviation.
+         * @param imageBGR Input image in BGR format.
+         * @return Normalized floating point image in RGB format.
+         */
+        static cv::Mat Normalize(const cv::Mat& imageBGR);
+
         /**
          * @brief Instance of the enet_b0_8_best_vgaf_embed2 model. 
          * Set by ExpressionNeutrality.cnn1_model_path in the configuration file.
@@ -79,5 +86,11 @@ namespace OFIQ_LIB::modules::measures
          * Set by ExpressionNeutrality.adaboost_model_path in the configuration file.
          */
         std::shared_ptr<cv::ml::Boost> m_classifier;
+
+        /**
+         * @brief If true, the network input is sampled directly from the input image,
+         * see \link OFIQ_LIB::GeometryPlan GeometryPlan\endlink.
+         */
+        bool m_directWarp{false};
     };
 }
\ No newline at end of file
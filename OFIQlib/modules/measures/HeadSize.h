@@ -55,5 +55,14 @@ namespace OFIQ_LIB::modules::measures
          * @param session Session object containing the original facial image and pre-processing results.
          */
         void Execute(OFIQ_LIB::Session & session) override;
+
+        /**
+         * @brief Returns the argument of the quality mapping, which is the deviation
+         * \f$|T/H-0.45|\f$ of the native quality score from its optimum.
+         * @param measure Enum value of the measure.
+         * @param rawValue Native quality score.
+         * @return Argument of the quality mapping.
+         */
+        double MappingInput(OFIQ::QualityMeasure measure, double rawValue) const override;
     };
 }
\ No newline at end of file
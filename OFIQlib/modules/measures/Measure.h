@@ -27,8 +27,10 @@
 #pragma once
 
 #include "Configuration.h"
+#include "MeasureRegistry.h"
 #include "ofiq_lib.h"
 #include "Session.h"
+#include <array>
 #ifndef _WIN32
 #    include <math.h>
 #endif
@@ -192,6 +194,21 @@ namespace OFIQ_LIB::modules::measures
          */
         void SetQualityMeasure(OFIQ_LIB::Session& session, OFIQ::QualityMeasure measure, double rawValue, OFIQ::QualityMeasureReturnCode code);
 
+        /**
+         * @brief Recomputes quality component values from stored native quality scores.
+         * @details The sigmoid-based quality mapping of <code>measure</code> is applied to all
+         * native quality scores in a single pass. Entries whose stored quality component value is
+         * negative belong to results that were not assessed successfully and are left unchanged.
+         * @param measure Enum value of the measure or measure component.
+         * @param rawScores Native quality scores.
+         * @param scalars Stored quality component values on input, recomputed values on output;
+         * must have the same size as <code>rawScores</code>.
+         * @return false if the quality component values of <code>measure</code> are not
+         * computed by a sigmoid-based quality mapping of this measure; <code>scalars</code>
+         * is not modified in that case.
+         */
+        bool RescoreScalars(OFIQ::QualityMeasure measure, const std::vector<double>& rawScores, std::vector<double>& scalars) const;
+
     protected:
         /**
          * @brief Sigmoid function.
@@ -227,16 +244,18 @@ namespace OFIQ_LIB::modules::measures
          * If a parameter is not configured,  its default value is chosen from the
          * <code>defaultValues</code> argument.
          * @param key Key/name of the measure of which mapping
-         * is configured.
+         * is configured. The name is resolved to its enum value using the
+         * \link OFIQ_LIB::modules::measures::measureRegistry measureRegistry\endlink.
          * @param defaultValues Parameters from which default values of
          * non-configured parameters are chosen.
+         * @throws OFIQError if <code>key</code> is not the name of a registered measure.
          */
         void AddSigmoid(const std::string& key, SigmoidParameters defaultValues);
 
         /**
          * @brief Maps a native quality score to a quality component value.
          * @param measure Enum value of the measure used to read parameters from a
-         * private map member.
+         * private table member indexed by the measure.
          * @param rawValue Native quality score.
          * @return Quality component value.
          */
@@ -245,12 +264,31 @@ namespace OFIQ_LIB::modules::measures
         /**
          * @brief Maps a native quality score to a quality component value.
          * @param key Key/name of the measure used to read parameters from a
-         * private map member.
+         * private table member; the name is resolved using the
+         * \link OFIQ_LIB::modules::measures::measureRegistry measureRegistry\endlink.
          * @param rawValue Native quality score.
          * @return Quality component value.
+         * @throws OFIQError if <code>key</code> is not the name of a registered measure.
          */
         double ExecuteScalarConversion(const std::string& key, double rawValue);
 
+        /**
+         * @brief Returns the argument of the sigmoid-based quality mapping of a native quality score.
+         * @details Unless overwritten, the native quality score is mapped directly. Measures that
+         * transform their native quality score before mapping it override this method and
+         * use it in their quality assessment so that
+         * \link OFIQ_LIB::modules::measures::Measure::RescoreScalars() RescoreScalars()\endlink
+         * reproduces their quality component values.
+         * @param measure Enum value of the measure or measure component.
+         * @param rawValue Native quality score.
+         * @return Argument of the quality mapping.
+         */
+        virtual double MappingInput(OFIQ::QualityMeasure measure, double rawValue) const
+        {
+            (void)measure;
+            return rawValue;
+        }
+
         /**
          * @brief Reference to the configuration with which the measure constructor
          * has been invoked.
@@ -285,13 +323,26 @@ namespace OFIQ_LIB::modules::measures
         }
 
         /**
-         * @brief Used to map the measure name to the sigmoid-based
-         * quality mapping function.
+         * @brief Sigmoid-based quality mapping functions indexed by
+         * \link OFIQ_LIB::modules::measures::MeasureIndex() MeasureIndex()\endlink.
+         * @details The last slot is used for measures that are not registered. Mappings
+         * that have not been added keep their default parameters.
          */
-        std::map<std::string, SigmoidParameters, std::less<>> m_sigmoidMap;
+        std::array<SigmoidParameters, measureCount + 1> m_sigmoids;
+
+        /**
+         * @brief Flags indexed by \link OFIQ_LIB::modules::measures::MeasureIndex() MeasureIndex()\endlink
+         * that are set for the mappings added by
+         * \link OFIQ_LIB::modules::measures::Measure::AddSigmoid(OFIQ::QualityMeasure,const SigmoidParameters&)
+         * AddSigmoid()\endlink.
+         */
+        std::array<bool, measureCount + 1> m_hasSigmoid{};
         
         /**
          * @brief Returns the name of the specified measure.
+         * @details Registered measures are looked up in the
+         * \link OFIQ_LIB::modules::measures::measureRegistry measureRegistry\endlink; other enumerators
+         * such as <code>NotSet</code> are named by their enumerator.
          * @param measure Enum value of a measure.
          * @return std::string representation of the requested measure.
          */
@@ -306,6 +357,17 @@ namespace OFIQ_LIB::modules::measures
          */
         static std::string ExpandKey(std::string_view rawKey);
 
+        /**
+         * @brief Returns the sigmoid-based quality mapping of a measure.
+         * @param measure Enum value of a measure.
+         * @return Reference to the slot of the measure in 
+         * \link OFIQ_LIB::modules::measures::Measure::m_sigmoids m_sigmoids\endlink.
+         */
+        SigmoidParameters& GetSigmoid(OFIQ::QualityMeasure measure)
+        {
+            return m_sigmoids[MeasureIndex(measure)];
+        }
+
         /**
          * @brief Value encoding the measure type.
          * @details The value is set to \link OFIQ::QualityMeasure::NotSet QualityMeasure::NotSet\endlink
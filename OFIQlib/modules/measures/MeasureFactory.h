@@ -59,5 +59,22 @@ namespace OFIQ_LIB::modules::measures
          static std::unique_ptr<Measure> CreateMeasure(
             const OFIQ::QualityMeasure measure,
             const Configuration& configuration);
+
+         /**
+          * @brief Requests the creation of the implementations of several measures.
+          * @details Components of a compound measure (e.g., 
+          * \link OFIQ::QualityMeasure::HeadPoseYaw HeadPoseYaw\endlink) are computed by the 
+          * implementation of the compound measure. Each implementation is created at most once, 
+          * no matter how many of its components are requested, such that no work is executed twice.
+          * Measures not contained in the \link OFIQ_LIB::modules::measures::measureRegistry 
+          * measureRegistry\endlink are skipped.
+          * @param measures Enum values encoding the requested measures.
+          * @param configuration Configuration from which measure parameters
+          * are read.
+          * @return Measure implementations in the order of their first request.
+          */
+         static std::vector<std::unique_ptr<Measure>> CreateMeasures(
+            const std::vector<OFIQ::QualityMeasure>& measures,
+            const Configuration& configuration);
     };
 }
@@ -0,0 +1,223 @@
+/**
+ * @file MeasureRegistry.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Provides a compile-time registry of the measures known to OFIQ.
+ * @author OFIQ development team
+ */
+#pragma once
+
+#include "ofiq_lib.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+ /**
+  * @brief Provides measures implemented in OFIQ.
+  */
+namespace OFIQ_LIB::modules::measures
+{
+    /**
+     * @brief Entry of the measure registry.
+     */
+    struct MeasureRegistryEntry
+    {
+        /**
+         * @brief Enum value of the measure.
+         */
+        OFIQ::QualityMeasure measure;
+
+        /**
+         * @brief Measure whose implementation computes this measure.
+         * @details Equal to <code>measure</code> except for the components of the compound measures
+         * \link OFIQ::QualityMeasure::Luminance Luminance\endlink,
+         * \link OFIQ::QualityMeasure::CropOfTheFaceImage CropOfTheFaceImage\endlink and
+         * \link OFIQ::QualityMeasure::HeadPose HeadPose\endlink.
+         */
+        OFIQ::QualityMeasure implementation;
+
+        /**
+         * @brief Name of the measure as used in the configuration.
+         */
+        std::string_view name;
+    };
+
+    /**
+     * @brief Registry of all measures; the position of an entry is the dense index of the measure.
+     */
+    inline constexpr std::array<MeasureRegistryEntry, 31> measureRegistry
+    {{
+        {OFIQ::QualityMeasure::UnifiedQualityScore, OFIQ::QualityMeasure::UnifiedQualityScore, "UnifiedQualityScore"},
+        {OFIQ::QualityMeasure::BackgroundUniformity, OFIQ::QualityMeasure::BackgroundUniformity, "BackgroundUniformity"},
+        {OFIQ::QualityMeasure::IlluminationUniformity, OFIQ::QualityMeasure::IlluminationUniformity, "IlluminationUniformity"},
+        {OFIQ::QualityMeasure::Luminance, OFIQ::QualityMeasure::Luminance, "Luminance"},
+        {OFIQ::QualityMeasure::LuminanceMean, OFIQ::QualityMeasure::Luminance, "LuminanceMean"},
+        {OFIQ::QualityMeasure::LuminanceVariance, OFIQ::QualityMeasure::Luminance, "LuminanceVariance"},
+        {OFIQ::QualityMeasure::UnderExposurePrevention, OFIQ::QualityMeasure::UnderExposurePrevention, "UnderExposurePrevention"},
+        {OFIQ::QualityMeasure::OverExposurePrevention, OFIQ::QualityMeasure::OverExposurePrevention, "OverExposurePrevention"},
+        {OFIQ::QualityMeasure::DynamicRange, OFIQ::QualityMeasure::DynamicRange, "DynamicRange"},
+        {OFIQ::QualityMeasure::Sharpness, OFIQ::QualityMeasure::Sharpness, "Sharpness"},
+        {OFIQ::QualityMeasure::CompressionArtifacts, OFIQ::QualityMeasure::CompressionArtifacts, "CompressionArtifacts"},
+        {OFIQ::QualityMeasure::NaturalColour, OFIQ::QualityMeasure::NaturalColour, "NaturalColour"},
+        {OFIQ::QualityMeasure::SingleFacePresent, OFIQ::QualityMeasure::SingleFacePresent, "SingleFacePresent"},
+        {OFIQ::QualityMeasure::EyesOpen, OFIQ::QualityMeasure::EyesOpen, "EyesOpen"},
+        {OFIQ::QualityMeasure::MouthClosed, OFIQ::QualityMeasure::MouthClosed, "MouthClosed"},
+        {OFIQ::QualityMeasure::EyesVisible, OFIQ::QualityMeasure::EyesVisible, "EyesVisible"},
+        {OFIQ::QualityMeasure::MouthOcclusionPrevention, OFIQ::QualityMeasure::MouthOcclusionPrevention, "MouthOcclusionPrevention"},
+        {OFIQ::QualityMeasure::FaceOcclusionPrevention, OFIQ::QualityMeasure::FaceOcclusionPrevention, "FaceOcclusionPrevention"},
+        {OFIQ::QualityMeasure::InterEyeDistance, OFIQ::QualityMeasure::InterEyeDistance, "InterEyeDistance"},
+        {OFIQ::QualityMeasure::HeadSize, OFIQ::QualityMeasure::HeadSize, "HeadSize"},
+        {OFIQ::QualityMeasure::CropOfTheFaceImage, OFIQ::QualityMeasure::CropOfTheFaceImage, "CropOfTheFaceImage"},
+        {OFIQ::QualityMeasure::LeftwardCropOfTheFaceImage, OFIQ::QualityMeasure::CropOfTheFaceImage, "LeftwardCropOfTheFaceImage"},
+        {OFIQ::QualityMeasure::RightwardCropOfTheFaceImage, OFIQ::QualityMeasure::CropOfTheFaceImage, "RightwardCropOfTheFaceImage"},
+        {OFIQ::QualityMeasure::MarginAboveOfTheFaceImage, OFIQ::QualityMeasure::CropOfTheFaceImage, "MarginAboveOfTheFaceImage"},
+        {OFIQ::QualityMeasure::MarginBelowOfTheFaceImage, OFIQ::QualityMeasure::CropOfTheFaceImage, "MarginBelowOfTheFaceImage"},
+        {OFIQ::QualityMeasure::HeadPose, OFIQ::QualityMeasure::HeadPose, "HeadPose"},
+        {OFIQ::QualityMeasure::HeadPoseYaw, OFIQ::QualityMeasure::HeadPose, "HeadPoseYaw"},
+        {OFIQ::QualityMeasure::HeadPosePitch, OFIQ::QualityMeasure::HeadPose, "HeadPosePitch"},
+        {OFIQ::QualityMeasure::HeadPoseRoll, OFIQ::QualityMeasure::HeadPose, "HeadPoseRoll"},
+        {OFIQ::QualityMeasure::ExpressionNeutrality, OFIQ::QualityMeasure::ExpressionNeutrality, "ExpressionNeutrality"},
+        {OFIQ::QualityMeasure::NoHeadCoverings, OFIQ::QualityMeasure::NoHeadCoverings, "NoHeadCoverings"}
+    }};
+
+    /**
+     * @brief Number of measures in the registry.
+     */
+    inline constexpr size_t measureCount = measureRegistry.size();
+
+    /**
+     * @brief Dense index returned for values not contained in the registry (e.g.,
+     * \link OFIQ::QualityMeasure::NotSet QualityMeasure::NotSet\endlink).
+     */
+    inline constexpr size_t invalidMeasureIndex = measureCount;
+
+    /**
+     * @brief Maps the enum values to a byte-sized key.
+     * @details The enum values of the measures lie in [-0x58, 0x5c], so their lowest byte is unique.
+     */
+    constexpr uint8_t MeasureKey(OFIQ::QualityMeasure measure)
+    {
+        return static_cast<uint8_t>(static_cast<int>(measure) & 0xff);
+    }
+
+    /**
+     * @brief Lookup table from \link MeasureKey \endlink to the dense index, computed at compile time.
+     */
+    inline constexpr std::array<uint8_t, 256> measureIndexTable = []()
+    {
+        std::array<uint8_t, 256> table{};
+        table.fill(static_cast<uint8_t>(invalidMeasureIndex));
+        for (size_t i = 0; i < measureRegistry.size(); i++)
+            table[MeasureKey(measureRegistry[i].measure)] = static_cast<uint8_t>(i);
+        return table;
+    }();
+
+    /**
+     * @brief Returns the dense index of a measure in constant time.
+     * @param measure Enum value of the measure.
+     * @return Index into \link measureRegistry \endlink or \link invalidMeasureIndex \endlink.
+     */
+    constexpr size_t MeasureIndex(OFIQ::QualityMeasure measure)
+    {
+        const size_t index = measureIndexTable[MeasureKey(measure)];
+        if (index == invalidMeasureIndex || measureRegistry[index].measure != measure)
+            return invalidMeasureIndex;
+        return index;
+    }
+
+    /**
+     * @brief Returns the configuration name of a measure.
+     * @param measure Enum value of the measure.
+     * @return Name of the measure or an empty view if the measure is not registered.
+     */
+    constexpr std::string_view MeasureName(OFIQ::QualityMeasure measure)
+    {
+        const size_t index = MeasureIndex(measure);
+        return index == invalidMeasureIndex ? std::string_view{} : measureRegistry[index].name;
+    }
+
+    /**
+     * @brief Returns the measure whose implementation computes the specified measure.
+     * @param measure Enum value of the measure.
+     * @return The compound measure for its components; otherwise the measure itself.
+     */
+    constexpr OFIQ::QualityMeasure ImplementingMeasure(OFIQ::QualityMeasure measure)
+    {
+        const size_t index = MeasureIndex(measure);
+        return index == invalidMeasureIndex ? measure : measureRegistry[index].implementation;
+    }
+
+    /**
+     * @brief Looks up a measure by its configuration name.
+     * @param name Name of the measure.
+     * @return Enum value or \link OFIQ::QualityMeasure::NotSet QualityMeasure::NotSet\endlink if the name is unknown.
+     */
+    constexpr OFIQ::QualityMeasure MeasureFromName(std::string_view name)
+    {
+        for (const auto& entry : measureRegistry)
+        {
+            if (entry.name == name)
+                return entry.measure;
+        }
+        return OFIQ::QualityMeasure::NotSet;
+    }
+
+    /**
+     * @brief Checks whether a measure reads the face parsing or the face occlusion segmentation.
+     * @details Such measures cannot be evaluated before the segmentation networks have run, e.g.,
+     * as gates of the assessment cascade (see \link OFIQ_LIB::modules::measures::Executor::SetCascade
+     * Executor::SetCascade\endlink).
+     * @param measure Enum value of the measure or of one of its components.
+     * @return true if the implementation of the measure depends on a segmentation.
+     */
+    constexpr bool RequiresSegmentation(OFIQ::QualityMeasure measure)
+    {
+        switch (ImplementingMeasure(measure))
+        {
+        case OFIQ::QualityMeasure::BackgroundUniformity:
+        case OFIQ::QualityMeasure::UnderExposurePrevention:
+        case OFIQ::QualityMeasure::OverExposurePrevention:
+        case OFIQ::QualityMeasure::EyesVisible:
+        case OFIQ::QualityMeasure::MouthOcclusionPrevention:
+        case OFIQ::QualityMeasure::FaceOcclusionPrevention:
+        case OFIQ::QualityMeasure::NoHeadCoverings:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static_assert(measureCount < 0xff, "dense indices must fit into a byte");
+    static_assert([]()
+        {
+            for (size_t i = 0; i < measureRegistry.size(); i++)
+            {
+                if (MeasureIndex(measureRegistry[i].measure) != i)
+                    return false;
+            }
+            return true;
+        }(), "measure keys must be unique");
+    static_assert(MeasureIndex(OFIQ::QualityMeasure::NotSet) == invalidMeasureIndex);
+    static_assert(MeasureIndex(OFIQ::QualityMeasure::HeadPose) != MeasureIndex(OFIQ::QualityMeasure::HeadPoseYaw));
+    static_assert(ImplementingMeasure(OFIQ::QualityMeasure::LuminanceVariance) == OFIQ::QualityMeasure::Luminance);
+}
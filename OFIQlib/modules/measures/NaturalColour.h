@@ -61,12 +61,12 @@ namespace OFIQ_LIB::modules::measures
 
     private:
         /**
-         * @brief Creates a mask image from the convex full of the specified landmarks.
-         * @param landmarks Facial landmarks.
+         * @brief Masks an image with the convex hull of the facial landmarks.
+         * @param faceMask Mask computed from the convex hull of the facial landmarks.
          * @param cvImage The mask image returned has the same dimension as <code>cvImage</code>.
          * @return Mask image
          */
-        cv::Mat CreateMaskedImage(const OFIQ::FaceLandmarks& landmarks, const cv::Mat& cvImage) const;
+        cv::Mat CreateMaskedImage(const RoiMask& faceMask, const cv::Mat& cvImage) const;
 
         /**
          * @brief Extracts two rectangular regions from an image and returns its concatenation.
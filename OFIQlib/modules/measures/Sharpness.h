@@ -99,7 +99,7 @@ namespace OFIQ_LIB::modules::measures
          * @param faceRegionAlpha Enlarge the face region by passing this parameter.
          */
         void GetCroppedImages(
-            const Session& session,
+            Session& session,
             cv::Mat& faceCrop,
             cv::Mat& maskCrop,
             bool useAligned,
@@ -28,6 +28,7 @@
 #include "OFIQError.h"
 #include "utils.h"
 #include "image_utils.h"
+#include "segmentations.h"
 
 namespace OFIQ_LIB::modules::measures
 {
@@ -51,6 +52,17 @@ namespace OFIQ_LIB::modules::measures
 
     void BackgroundUniformity::Execute(OFIQ_LIB::Session & session)
     {
+        // Without background pixels in the rows of S used below, the background mask B
+        // computed in step 6 is empty; the class counts of the face parsing tell this
+        // without creating the padding mask and scanning the images.
+        const auto background = static_cast<int>(OFIQ_LIB::modules::segmentations::SegmentClassLabels::background);
+        if (session.getFaceParsingClassCounts().count(background, 0, m_targetHeight) == 0)
+        {
+            double rawScore = 0.0;
+            SetQualityMeasure(session, qualityMeasure, rawScore, OFIQ::QualityMeasureReturnCode::FailureToAssess);
+            return;
+        }
+
         // Input: Aligned image I
         auto I = session.getAlignedFace();
 
@@ -58,7 +70,7 @@ namespace OFIQ_LIB::modules::measures
         auto T = session.getAlignedFaceTransformationMatrix();
 
         // Input: face parsing segmentation map S
-        auto S = session.getFaceParsingImage();
+        cv::Mat S = session.faceParsingImage();
 
         // Input: dimensions (w,h) of the original image
         auto h = session.image().height;
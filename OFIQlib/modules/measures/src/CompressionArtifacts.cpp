@@ -25,6 +25,7 @@
  */
 
 #include "CompressionArtifacts.h"
+#include "GeometryPlan.h"
 #include "OFIQError.h"
 #include "FaceMeasures.h"
 #include "FaceParts.h"
@@ -65,6 +66,8 @@ namespace OFIQ_LIB::modules::measures
         else
             m_dim = 248;
 
+        m_directWarp = GeometryPlan::IsDirectWarpEnabled(configuration);
+
         try
         {
             std::ifstream instream(modelPath, std::ios::in | std::ios::binary);
@@ -84,11 +87,22 @@ namespace OFIQ_LIB::modules::measures
 
     void CompressionArtifacts::Execute(OFIQ_LIB::Session& session)
     {
-        cv::Mat inputImage = session.getAlignedFace();
-        auto width = inputImage.cols;
-        auto height = inputImage.rows;
+        cv::Mat cropped;
+        if (m_directWarp)
+        {
+            const int size = GeometryPlan::alignedFaceSize - 2 * m_crop;
+            cropped = GeometryPlan::FromAlignedFace(session)
+                .crop(cv::Rect(m_crop, m_crop, size, size))
+                .warp(session.getImageBGR());
+        }
+        else
+        {
+            cv::Mat inputImage = session.getAlignedFace();
+            auto width = inputImage.cols;
+            auto height = inputImage.rows;
 
-        auto cropped = inputImage(cv::Rect(m_crop, m_crop, width - 2 * m_crop, height - 2 * m_crop));
+            cropped = inputImage(cv::Rect(m_crop, m_crop, width - 2 * m_crop, height - 2 * m_crop));
+        }
 
         auto transformed = cropped;
         cv::cvtColor(cropped, transformed, cv::COLOR_BGR2RGB);
@@ -70,10 +70,10 @@ namespace OFIQ_LIB::modules::measures
     void CropOfTheFaceImage::Execute(OFIQ_LIB::Session & session)
     {
         auto faceLandmarks = session.getLandmarks();
-        auto leftEyePoints = landmarks::PartExtractor::getFacePart(
+        auto leftEyePoints = landmarks::PartExtractor::getFacePartPoints(
             faceLandmarks,
             landmarks::FaceParts::LEFT_EYE_CORNERS);
-        auto rightEyePoints = landmarks::PartExtractor::getFacePart(
+        auto rightEyePoints = landmarks::PartExtractor::getFacePartPoints(
             faceLandmarks,
             landmarks::FaceParts::RIGHT_EYE_CORNERS);
 
@@ -82,7 +82,7 @@ namespace OFIQ_LIB::modules::measures
 
         auto eyeMidPoint =
             landmarks::FaceMeasures::GetMiddle(OFIQ::Landmarks{ leftEyeCenter, rightEyeCenter });
-        auto chinPoint = PartExtractor::getFacePart(faceLandmarks, FaceParts::CHIN)[0];
+        auto chinPoint = PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::CHIN)[0];
         auto t = landmarks::FaceMeasures::GetDistance(eyeMidPoint, chinPoint);
         
         double interEyeDistance = landmarks::FaceMeasures::GetDistance(leftEyeCenter, rightEyeCenter);
@@ -61,7 +61,7 @@ namespace OFIQ_LIB::modules::measures
         {
             scalarScore = 100.0;
         }
-        session.assessment().qAssessments[qualityMeasure] = { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure, { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success });
     }
 
     static double ComputeEntropy(const cv::Mat& luminanceImage, const cv::Mat& maskImage)
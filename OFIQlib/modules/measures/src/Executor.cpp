@@ -25,6 +25,9 @@
  */
 
 #include "Executor.h"
+#include "MeasureRegistry.h"
+#include "OFIQError.h"
+#include <algorithm>
 
 namespace OFIQ_LIB::modules::measures
 {
@@ -37,22 +40,185 @@ namespace OFIQ_LIB::modules::measures
 
     void Executor::ExecuteAll(Session & i_currentSession) const
     {
-        int i = 1;
         log("\t");
+        Execute(i_currentSession, 0, m_measures.size());
+        log("\nfinished\n");
+    }
+
+    void Executor::SetCascade(const std::vector<CascadeGate>& gates)
+    {
+        m_gates.clear();
+        m_gateMeasureCounts.clear();
+        m_numberOfGateMeasures = 0;
+
+        for (const auto& gate : gates)
+        {
+            const auto gateName = std::string(MeasureName(gate.measure));
+            if (RequiresSegmentation(gate.measure))
+            {
+                throw OFIQError(
+                    OFIQ::ReturnCode::NotImplemented,
+                    "The cascade gate '" + gateName + "' depends on a segmentation and cannot be used as a gate");
+            }
+
+            const auto implementation = ImplementingMeasure(gate.measure);
+            auto it = std::find_if(m_measures.begin(), m_measures.end(),
+                [implementation](const auto& measure) { return measure->GetQualityMeasure() == implementation; });
+            if (it == m_measures.end())
+            {
+                throw OFIQError(
+                    OFIQ::ReturnCode::NotImplemented,
+                    "The cascade gate '" + gateName + "' is not an activated measure");
+            }
+
+            // move the measure behind the measures of the previous gates unless it is one of them
+            const auto position = static_cast<size_t>(std::distance(m_measures.begin(), it));
+            if (position >= m_numberOfGateMeasures)
+            {
+                std::rotate(
+                    m_measures.begin() + static_cast<std::ptrdiff_t>(m_numberOfGateMeasures),
+                    it,
+                    it + 1);
+                m_numberOfGateMeasures++;
+            }
+
+            m_gates.push_back(gate);
+            m_gateMeasureCounts.push_back(m_numberOfGateMeasures);
+        }
+    }
+
+    bool Executor::ExecuteGates(Session & i_currentSession) const
+    {
+        log("\t");
+        size_t executed = 0;
+        for (size_t i = 0; i < m_gates.size(); i++)
+        {
+            Execute(i_currentSession, executed, m_gateMeasureCounts[i]);
+            executed = m_gateMeasureCounts[i];
+            if (i_currentSession.isCancelled())
+                return false;
+            // gates of measures not selected for this session are not checked
+            if (!IsSelected(i_currentSession, ImplementingMeasure(m_gates[i].measure)))
+                continue;
+            if (!PassesGate(i_currentSession, m_gates[i]))
+            {
+                log("gate " + std::string(MeasureName(m_gates[i].measure)) + " failed\n");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Executor::ExecuteRemaining(Session & i_currentSession) const
+    {
+        Execute(i_currentSession, m_numberOfGateMeasures, m_measures.size());
+        log("\nfinished\n");
+    }
+
+    void Executor::SetMissingResults(Session & i_currentSession, OFIQ::QualityMeasureReturnCode code) const
+    {
+        auto& results = i_currentSession.qualityResults();
         for (const auto& measure : m_measures)
         {
-            auto s = std::to_string(i);
-            log(s + ". " + measure->GetName() + " ");
+            // compound measures store their results under their components only
+            const auto implementation = measure->GetQualityMeasure();
+            if (!IsSelected(i_currentSession, implementation))
+                continue;
+            const bool isCompound = std::any_of(measureRegistry.begin(), measureRegistry.end(),
+                [implementation](const auto& entry) { return entry.implementation == implementation && entry.measure != implementation; });
+            for (const auto& entry : measureRegistry)
+            {
+                if (entry.implementation != implementation || (isCompound && entry.measure == implementation))
+                    continue;
+                if (!results.contains(entry.measure))
+                    results.set(entry.measure, { 0, -1, code });
+            }
+        }
+    }
+
+    bool Executor::RescoreScalars(OFIQ::QualityMeasure measure, const std::vector<double>& rawScores, std::vector<double>& scalars) const
+    {
+        const auto implementation = ImplementingMeasure(measure);
+        auto found = std::find_if(m_measures.begin(), m_measures.end(),
+            [implementation](const auto& candidate) { return candidate->GetQualityMeasure() == implementation; });
+        return found != m_measures.end() && (*found)->RescoreScalars(measure, rawScores, scalars);
+    }
+
+    bool Executor::RequiresSegmentations(const Session & i_currentSession) const
+    {
+        return std::any_of(m_measures.begin(), m_measures.end(),
+            [&i_currentSession](const auto& measure)
+            {
+                return RequiresSegmentation(measure->GetQualityMeasure()) &&
+                    IsSelected(i_currentSession, measure->GetQualityMeasure());
+            });
+    }
+
+    void Executor::Execute(Session & i_currentSession, size_t begin, size_t end) const
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (i_currentSession.isCancelled())
+                break;
+            const auto& measure = m_measures[i];
+            if (!IsSelected(i_currentSession, measure->GetQualityMeasure()))
+                continue;
+            log(std::to_string(i + 1) + ". " + measure->GetName() + " ");
             try {
                 measure->Execute(i_currentSession);
             }
             catch (...)
             {
+                // an inference terminated on cancellation leaves the result to be set to Skipped
+                if (i_currentSession.isCancelled())
+                    break;
                 measure->SetQualityMeasure(i_currentSession, measure->GetQualityMeasure(), .0f, OFIQ::QualityMeasureReturnCode::FailureToAssess);
                 log("Exception in " + measure->GetName() + "!!! ");
             }
-            ++i;
+            ReportResults(i_currentSession, measure->GetQualityMeasure());
         }
-        log("\nfinished\n");
     }
-}
\ No newline at end of file
+
+    void Executor::ReportResults(Session & i_currentSession, OFIQ::QualityMeasure implementation)
+    {
+        // compound measures report the results of their components only
+        const bool isCompound = std::any_of(measureRegistry.begin(), measureRegistry.end(),
+            [implementation](const auto& entry) { return entry.implementation == implementation && entry.measure != implementation; });
+        for (const auto& entry : measureRegistry)
+        {
+            if (entry.implementation != implementation || (isCompound && entry.measure == implementation))
+                continue;
+            if (!i_currentSession.reportMeasureResult(entry.measure))
+                return;
+        }
+    }
+
+    bool Executor::PassesGate(const Session & i_currentSession, const CascadeGate& gate)
+    {
+        const auto& results = i_currentSession.qualityResults();
+        bool checked = false;
+        for (const auto& entry : measureRegistry)
+        {
+            // a compound gate is checked on all of its components
+            if (entry.measure != gate.measure && entry.implementation != gate.measure)
+                continue;
+            const auto* result = results.find(entry.measure);
+            if (result == nullptr)
+                continue;
+            if (result->code != OFIQ::QualityMeasureReturnCode::Success || result->scalar < gate.minimumScalar)
+                return false;
+            checked = true;
+        }
+        return checked;
+    }
+
+    bool Executor::IsSelected(const Session & i_currentSession, OFIQ::QualityMeasure implementation)
+    {
+        const auto& selection = i_currentSession.measureSelection();
+        return std::any_of(measureRegistry.begin(), measureRegistry.end(),
+            [&selection, implementation](const auto& entry)
+            {
+                return entry.implementation == implementation && selection.contains(entry.measure);
+            });
+    }
+}
@@ -26,6 +26,7 @@
 
 #include "ExpressionNeutrality.h"
 #include "FaceMeasures.h"
+#include "GeometryPlan.h"
 #include "OFIQError.h"
 #include <fstream>
 #include <opencv2/ml.hpp>
@@ -92,6 +93,8 @@ namespace OFIQ_LIB::modules::measures
                 std::string("Loading adaboost model for expression neutrality failed"));
         }
 
+        m_directWarp = GeometryPlan::IsDirectWarpEnabled(configuration);
+
         SigmoidParameters defaultValues;
         defaultValues.h = 100.0;
         defaultValues.x0 = -5000.0;
@@ -100,13 +103,10 @@ namespace OFIQ_LIB::modules::measures
         AddSigmoid(qualityMeasure, defaultValues);
     }
 
-    void ExpressionNeutrality::Execute(OFIQ_LIB::Session& session)
+    cv::Mat ExpressionNeutrality::Normalize(const cv::Mat& imageBGR)
     {
-        cv::Mat aligned = session.getAlignedFace();
-        auto cropped = aligned(cv::Rect(144, 148, 328, 340));
-
-        auto transformed = cropped;
-        cv::cvtColor(cropped, transformed, cv::COLOR_BGR2RGB);
+        cv::Mat transformed;
+        cv::cvtColor(imageBGR, transformed, cv::COLOR_BGR2RGB);
 
         const cv::Scalar mean(0.485, 0.456, 0.406);
         const cv::Scalar std(0.229, 0.224, 0.225);
@@ -115,8 +115,31 @@ namespace OFIQ_LIB::modules::measures
         transformed /= 255.0;
         transformed -= mean;
         transformed /= std;
+        return transformed;
+    }
+
+    void ExpressionNeutrality::Execute(OFIQ_LIB::Session& session)
+    {
+        const cv::Rect crop(144, 148, 328, 340);
         cv::Mat resized1;
-        cv::resize(transformed, resized1, cv::Size(dimCNN1, dimCNN1), 0, 0, cv::INTER_LINEAR);
+        cv::Mat resized2;
+        if (m_directWarp)
+        {
+            // sample both network inputs directly from the input image
+            const auto& imageBGR = session.getImageBGR();
+            resized1 = Normalize(GeometryPlan::FromAlignedFace(session)
+                .crop(crop).resize(cv::Size(dimCNN1, dimCNN1)).warp(imageBGR));
+            resized2 = Normalize(GeometryPlan::FromAlignedFace(session)
+                .crop(crop).resize(cv::Size(dimCNN2, dimCNN2)).warp(imageBGR));
+        }
+        else
+        {
+            cv::Mat aligned = session.getAlignedFace();
+            auto transformed = Normalize(aligned(crop));
+            cv::resize(transformed, resized1, cv::Size(dimCNN1, dimCNN1), 0, 0, cv::INTER_LINEAR);
+            cv::resize(transformed, resized2, cv::Size(dimCNN2, dimCNN2), 0, 0, cv::INTER_LINEAR);
+        }
+
         cv::Mat blob = cv::dnn::blobFromImage({ resized1 });
 
         std::vector<float> net_input;
@@ -124,8 +147,6 @@ namespace OFIQ_LIB::modules::measures
         auto outCNN1 = m_onnxRuntimeEnvCNN1.run(net_input);
         auto features1 = cv::Mat(1, 1280, CV_32F, outCNN1[0].GetTensorMutableData<float>());
 
-        cv::Mat resized2;
-        cv::resize(transformed, resized2, cv::Size(dimCNN2, dimCNN2), 0, 0, cv::INTER_LINEAR);
         blob = cv::dnn::blobFromImage({ resized2 });
 
         net_input.clear();
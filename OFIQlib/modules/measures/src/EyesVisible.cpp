@@ -46,9 +46,9 @@ namespace OFIQ_LIB::modules::measures
     void EyesVisible::Execute(OFIQ_LIB::Session & session)
     {
         auto alignedFaceLandmarks = session.getAlignedFaceLandmarks();
-        cv::Mat faceOcclusionMask = session.getFaceOcclusionSegmentationImage();
-        OFIQ::Landmarks leftEye = PartExtractor::getFacePart(alignedFaceLandmarks, FaceParts::LEFT_EYE);
-        OFIQ::Landmarks rightEye = PartExtractor::getFacePart(alignedFaceLandmarks, FaceParts::RIGHT_EYE);
+        const cv::Mat& faceOcclusionMask = session.faceOcclusionSegmentationImage();
+        auto leftEye = PartExtractor::getFacePartPoints(alignedFaceLandmarks, FaceParts::LEFT_EYE);
+        auto rightEye = PartExtractor::getFacePartPoints(alignedFaceLandmarks, FaceParts::RIGHT_EYE);
 
         auto headPose = session.getPose();
         auto interEyeDistance = landmarks::FaceMeasures::InterEyeDistance(alignedFaceLandmarks, headPose[1]);
@@ -91,12 +91,10 @@ namespace OFIQ_LIB::modules::measures
         };
 
         std::vector<std::vector<cv::Point2i>> contours = { leftRect, rightRect };
-        cv::Mat EVZMask = cv::Mat::zeros(faceOcclusionMask.size(), CV_8U);
-        cv::drawContours(EVZMask, contours, -1, 1, -1);
+        auto EVZMask = RoiMask::FromPolygons(faceOcclusionMask.size(), contours);
         
         // Compute proportion of occlusion of EVZ
-        cv::Mat occlusionMask = EVZMask.mul(1- faceOcclusionMask);
-        double rawScore = cv::sum(occlusionMask).val[0] / cv::sum(EVZMask).val[0];
+        double rawScore = EVZMask.countDifference(faceOcclusionMask) / static_cast<double>(EVZMask.countNonZero());
         double scalarScore = round(100 * (1 - rawScore));
         if (scalarScore < 0)
         {
@@ -106,6 +104,6 @@ namespace OFIQ_LIB::modules::measures
         {
             scalarScore = 100;
         }
-        session.assessment().qAssessments[qualityMeasure] = { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure, { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success });
     }
 }
\ No newline at end of file
@@ -42,8 +42,8 @@ namespace OFIQ_LIB::modules::measures
 
     void FaceOcclusionPrevention::Execute(OFIQ_LIB::Session & session)
     {
-        cv::Mat mask = session.getAlignedFaceLandmarkedRegion();
-        int G = cv::countNonZero(mask);
+        const RoiMask& mask = session.getAlignedFaceLandmarkedRegionRoi();
+        int G = mask.countNonZero();
         if (G == 0)
         {
             double rawScore = 0.0;
@@ -51,9 +51,9 @@ namespace OFIQ_LIB::modules::measures
             return;
         }
         
-        cv::Mat faceOcclusionMask = session.getFaceOcclusionSegmentationImage();
-        cv::Mat occlusionMask = mask.mul(1 - faceOcclusionMask);
-        double rawScore = cv::countNonZero(occlusionMask) / (double)G;
+        // count landmarked pixels which are not classified as face by the occlusion segmentation
+        const cv::Mat& faceOcclusionMask = session.faceOcclusionSegmentationImage();
+        double rawScore = mask.countDifference(faceOcclusionMask) / (double)G;
         double scalarScore = round(100 * (1 - rawScore));
         if (scalarScore < 0)
         {
@@ -63,6 +63,6 @@ namespace OFIQ_LIB::modules::measures
         {
             scalarScore = 100;
         }
-        session.assessment().qAssessments[qualityMeasure] = { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure, { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success });
     }
 }
@@ -51,11 +51,11 @@ namespace OFIQ_LIB::modules::measures
     {
         auto headPose = session.getPose();
 
-        session.assessment().qAssessments[OFIQ::QualityMeasure::HeadPoseRoll] =
-            CalculateQuality(headPose[2]);
-        session.assessment().qAssessments[OFIQ::QualityMeasure::HeadPosePitch] =
-            CalculateQuality(headPose[0]);
-        session.assessment().qAssessments[OFIQ::QualityMeasure::HeadPoseYaw] =
-            CalculateQuality(headPose[1]);
+        session.qualityResults().set(OFIQ::QualityMeasure::HeadPoseRoll,
+            CalculateQuality(headPose[2]));
+        session.qualityResults().set(OFIQ::QualityMeasure::HeadPosePitch,
+            CalculateQuality(headPose[0]));
+        session.qualityResults().set(OFIQ::QualityMeasure::HeadPoseYaw,
+            CalculateQuality(headPose[1]));
     }
 }
\ No newline at end of file
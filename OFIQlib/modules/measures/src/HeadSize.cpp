@@ -53,9 +53,14 @@ namespace OFIQ_LIB::modules::measures
         double T = tmetric(faceLandmarks);
 
         double rawScore = T / (double)session.image().height;
-        double convertedScore = abs(rawScore - 0.45);
+        double convertedScore = MappingInput(qualityMeasure, rawScore);
 
         auto scalarScore = ExecuteScalarConversion(qualityMeasure, convertedScore);
-        session.assessment().qAssessments[qualityMeasure] = {rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success};
+        session.qualityResults().set(qualityMeasure, {rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success});
+    }
+
+    double HeadSize::MappingInput(OFIQ::QualityMeasure, double rawValue) const
+    {
+        return abs(rawValue - 0.45);
     }
 }
\ No newline at end of file
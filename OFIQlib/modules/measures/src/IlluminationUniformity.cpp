@@ -89,7 +89,7 @@ namespace OFIQ_LIB::modules::measures
         double rawScore = cv::sum(minHistogram).val[0];
 
         double scalarScore = round(100 * (std::pow(rawScore, 0.3)));
-        session.assessment().qAssessments[qualityMeasure] = 
-            { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure,
+            { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success });
     }
 }
\ No newline at end of file
@@ -44,15 +44,16 @@ namespace OFIQ_LIB::modules::measures
         cv::Mat aligned = session.getAlignedFace();
 
         // Get landmarked region segmentation map
-        auto landmarks = session.getLandmarks();
-        auto mask = landmarks::FaceMeasures::GetFaceMask(session.getAlignedFaceLandmarks(), aligned.rows, aligned.cols);
+        auto mask = landmarks::FaceMeasures::GetCachedFaceMask(
+            session, session.getAlignedFaceLandmarks(), aligned.rows, aligned.cols);
 
-        // Recover the image luminance from RGB data of image
-        auto luminanceImage = GetLuminanceImageFromBGR(aligned);
+        // Recover the image luminance from RGB data of image; pixels outside
+        // the mask's region of interest do not contribute to the histogram
+        auto luminanceImage = GetLuminanceImageFromBGR(aligned(mask.roi()));
 
         // Compute the luminance histogram
         cv::Mat1f histogram;
-        GetNormalizedHistogram(luminanceImage, mask, histogram);
+        GetNormalizedHistogram(luminanceImage, mask.data(), histogram);
 
         // Compute the mean of the luminance histogram
         double mean = 0;
@@ -63,8 +64,8 @@ namespace OFIQ_LIB::modules::measures
         }
 
         double scalarScoreMean = round(100 * Sigmoid(mean, 0.2, 0.05) * (1 - Sigmoid(mean, 0.8, 0.05)));
-        session.assessment().qAssessments[OFIQ::QualityMeasure::LuminanceMean] = 
-            { mean, scalarScoreMean, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(OFIQ::QualityMeasure::LuminanceMean,
+            { mean, scalarScoreMean, OFIQ::QualityMeasureReturnCode::Success });
 
         // Compute the variance of the luminance histogram
         double variance = 0;
@@ -74,7 +75,7 @@ namespace OFIQ_LIB::modules::measures
         }
 
         double scalarScoreVariance = round(100 * sin((60 * variance) / (60 * variance + 1) * M_PI));
-        session.assessment().qAssessments[OFIQ::QualityMeasure::LuminanceVariance] = 
-            { variance, scalarScoreVariance, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(OFIQ::QualityMeasure::LuminanceVariance,
+            { variance, scalarScoreVariance, OFIQ::QualityMeasureReturnCode::Success });
     }
 }
\ No newline at end of file
@@ -25,36 +25,52 @@
  */
 
 #include "Measure.h"
-
+#include "OFIQError.h"
 #include <magic_enum.hpp>
 
 namespace OFIQ_LIB::modules::measures
 {
-    void Measure::AddSigmoid(OFIQ::QualityMeasure measure, const SigmoidParameters& defaultValues)
+    /**
+     * @brief Resolves the name of a measure using the measure registry.
+     * @param key Name of the measure.
+     * @return Enum value of the measure.
+     * @throws OFIQError if the name is not registered.
+     */
+    static OFIQ::QualityMeasure RegisteredMeasure(const std::string& key)
     {
-        AddSigmoid(GetMeasureName(measure), defaultValues);
+        const auto measure = MeasureFromName(key);
+        if (measure == OFIQ::QualityMeasure::NotSet)
+            throw OFIQError(OFIQ::ReturnCode::NotImplemented, "Unknown measure '" + key + "'");
+        return measure;
     }
 
-    void Measure::AddSigmoid(const std::string& key, SigmoidParameters sigmoidParams)
+    void Measure::AddSigmoid(OFIQ::QualityMeasure measure, const SigmoidParameters& defaultValues)
     {
-        auto extendedKey = ExpandKey(key);
+        SigmoidParameters sigmoidParams = defaultValues;
+        auto extendedKey = ExpandKey(MeasureName(measure));
         configuration.GetNumber(extendedKey + "h", sigmoidParams.h);
         configuration.GetNumber(extendedKey + "a", sigmoidParams.a);
         configuration.GetNumber(extendedKey + "s", sigmoidParams.s);
         configuration.GetNumber(extendedKey + "x0", sigmoidParams.x0);
         configuration.GetNumber(extendedKey + "w", sigmoidParams.w);
         configuration.GetBool(extendedKey + "round", sigmoidParams.round);
-        m_sigmoidMap[key] = sigmoidParams;
+        GetSigmoid(measure) = sigmoidParams;
+        m_hasSigmoid[MeasureIndex(measure)] = true;
+    }
+
+    void Measure::AddSigmoid(const std::string& key, SigmoidParameters sigmoidParams)
+    {
+        AddSigmoid(RegisteredMeasure(key), sigmoidParams);
     }
 
     double Measure::ExecuteScalarConversion(OFIQ::QualityMeasure measure, double rawValue)
     {
-        return ExecuteScalarConversion(GetMeasureName(measure), rawValue);
+        return ScalarConversion(rawValue, GetSigmoid(measure));
     }
 
     double Measure::ExecuteScalarConversion(const std::string& key, double rawValue)
     {
-        return ScalarConversion(rawValue, m_sigmoidMap[key]);
+        return ExecuteScalarConversion(RegisteredMeasure(key), rawValue);
     }
 
     void Measure::SetQualityMeasure(OFIQ_LIB::Session& session, OFIQ::QualityMeasure measure, double rawScore, OFIQ::QualityMeasureReturnCode code)
@@ -68,7 +84,24 @@ namespace OFIQ_LIB::modules::measures
         {
             scalarScore = ExecuteScalarConversion(measure, rawScore);
         }
-        session.assessment().qAssessments[measure] = {rawScore, scalarScore, code};
+        session.qualityResults().set(measure, {rawScore, scalarScore, code});
+    }
+
+    bool Measure::RescoreScalars(OFIQ::QualityMeasure measure, const std::vector<double>& rawScores, std::vector<double>& scalars) const
+    {
+        const size_t index = MeasureIndex(measure);
+        if (index == invalidMeasureIndex || !m_hasSigmoid[index] || ImplementingMeasure(measure) != m_measure)
+            return false;
+        if (rawScores.size() != scalars.size())
+            throw OFIQError(OFIQ::ReturnCode::UnknownError, "Numbers of native quality scores and quality component values differ");
+
+        const SigmoidParameters& par = m_sigmoids[index];
+        for (size_t i = 0; i < rawScores.size(); i++)
+        {
+            if (scalars[i] >= 0.0)
+                scalars[i] = ScalarConversion(MappingInput(measure, rawScores[i]), par);
+        }
+        return true;
     }
 
     std::string Measure::GetName() const
@@ -78,6 +111,9 @@ namespace OFIQ_LIB::modules::measures
 
     std::string Measure::GetMeasureName(OFIQ::QualityMeasure measure)
     {
+        if (const auto name = MeasureName(measure); !name.empty())
+            return static_cast<std::string>(name);
+        // enumerators that are no registered measure (i.e. NotSet) keep their enum name
         return static_cast<std::string>(magic_enum::enum_name(measure));
     }
 
@@ -28,7 +28,6 @@
 #include "AllMeasures.h"
 
 #include <memory>
-#include <magic_enum.hpp>
 
 namespace OFIQ_LIB::modules::measures
 { 
@@ -36,9 +35,6 @@ namespace OFIQ_LIB::modules::measures
     {
         {OFIQ::QualityMeasure::SingleFacePresent, [](const Configuration& configuration) { return std::make_unique<SingleFacePresent>(configuration); }},
         {OFIQ::QualityMeasure::HeadPose, [](const Configuration& configuration) { return std::make_unique<HeadPose>(configuration); }},
-        {OFIQ::QualityMeasure::HeadPoseRoll, [](const Configuration& configuration) { return std::make_unique<HeadPose>(configuration); }},
-        {OFIQ::QualityMeasure::HeadPosePitch, [](const Configuration& configuration) { return std::make_unique<HeadPose>(configuration); }},
-        {OFIQ::QualityMeasure::HeadPoseYaw, [](const Configuration& configuration) { return std::make_unique<HeadPose>(configuration); }},
         {OFIQ::QualityMeasure::UnderExposurePrevention, [](const Configuration& configuration) { return std::make_unique<UnderExposurePrevention>(configuration); }},
         {OFIQ::QualityMeasure::OverExposurePrevention, [](const Configuration& configuration) { return std::make_unique<OverExposurePrevention>(configuration); }},
         {OFIQ::QualityMeasure::BackgroundUniformity, [](const Configuration& configuration) { return std::make_unique<BackgroundUniformity>(configuration); }},
@@ -51,14 +47,8 @@ namespace OFIQ_LIB::modules::measures
         {OFIQ::QualityMeasure::IlluminationUniformity, [](const Configuration& configuration) { return std::make_unique<IlluminationUniformity>(configuration); }},
         {OFIQ::QualityMeasure::InterEyeDistance, [](const Configuration& configuration) { return std::make_unique<InterEyeDistance>(configuration); }},
         {OFIQ::QualityMeasure::Luminance, [](const Configuration& configuration) { return std::make_unique<Luminance>(configuration); }},
-        {OFIQ::QualityMeasure::LuminanceMean, [](const Configuration& configuration) { return std::make_unique<Luminance>(configuration); }},
-        {OFIQ::QualityMeasure::LuminanceVariance, [](const Configuration& configuration) { return std::make_unique<Luminance>(configuration); }},
         {OFIQ::QualityMeasure::DynamicRange, [](const Configuration& configuration) { return std::make_unique<DynamicRange>(configuration); }},
         {OFIQ::QualityMeasure::CropOfTheFaceImage, [](const Configuration& configuration) { return std::make_unique<CropOfTheFaceImage>(configuration); }},
-        {OFIQ::QualityMeasure::LeftwardCropOfTheFaceImage, [](const Configuration& configuration) { return std::make_unique<CropOfTheFaceImage>(configuration); }},
-        {OFIQ::QualityMeasure::RightwardCropOfTheFaceImage, [](const Configuration& configuration) { return std::make_unique<CropOfTheFaceImage>(configuration); }},
-        {OFIQ::QualityMeasure::MarginBelowOfTheFaceImage, [](const Configuration& configuration) { return std::make_unique<CropOfTheFaceImage>(configuration); }},
-        {OFIQ::QualityMeasure::MarginAboveOfTheFaceImage, [](const Configuration& configuration) { return std::make_unique<CropOfTheFaceImage>(configuration); }},
         {OFIQ::QualityMeasure::NaturalColour, [](const Configuration& configuration) { return std::make_unique<NaturalColour>(configuration); }},
         {OFIQ::QualityMeasure::CompressionArtifacts, [](const Configuration& configuration) { return std::make_unique<CompressionArtifacts>(configuration); }},
         {OFIQ::QualityMeasure::HeadSize, [](const Configuration& configuration) { return std::make_unique<HeadSize>(configuration); }},
@@ -71,7 +61,7 @@ namespace OFIQ_LIB::modules::measures
         const OFIQ::QualityMeasure measure,
         const Configuration& configuration)
     {   
-        auto it = factoryMapping.find(measure);
+        auto it = factoryMapping.find(ImplementingMeasure(measure));
         if (it != factoryMapping.end())
         {
             return it->second(configuration);
@@ -81,4 +71,21 @@ namespace OFIQ_LIB::modules::measures
             return nullptr;
         }
     }
-}
\ No newline at end of file
+
+    std::vector<std::unique_ptr<Measure>> MeasureFactory::CreateMeasures(
+        const std::vector<OFIQ::QualityMeasure>& measures,
+        const Configuration& configuration)
+    {
+        std::array<bool, measureCount + 1> created{};
+        std::vector<std::unique_ptr<Measure>> measureInstances;
+        for (auto measure : measures)
+        {
+            const size_t index = MeasureIndex(ImplementingMeasure(measure));
+            if (index == invalidMeasureIndex || created[index])
+                continue;
+            created[index] = true;
+            measureInstances.emplace_back(CreateMeasure(measure, configuration));
+        }
+        return measureInstances;
+    }
+}
@@ -41,8 +41,7 @@ namespace OFIQ_LIB::modules::measures
     void MouthOcclusionPrevention::Execute(OFIQ_LIB::Session & session)
     {
         auto alignedFaceLandmarks = session.getAlignedFaceLandmarks();
-        cv::Mat alignedFace = session.getAlignedFace();
-        cv::Mat faceOcclusionMask = session.getFaceOcclusionSegmentationImage();
+        const cv::Mat& faceOcclusionMask = session.faceOcclusionSegmentationImage();
 
         std::vector<cv::Point2i> landmarks;
         for (int i = 76; i < 88; i++)
@@ -50,11 +49,10 @@ namespace OFIQ_LIB::modules::measures
             landmarks.push_back({ alignedFaceLandmarks.landmarks[i].x, alignedFaceLandmarks.landmarks[i].y });
         }
 
-        cv::Mat mask = cv::Mat::zeros(alignedFace.size(), CV_8UC1);
-        cv::fillConvexPoly(mask, landmarks, cv::Scalar(1));
+        // the occlusion mask has the size of the aligned face image
+        auto mask = RoiMask::FromConvexPolygon(faceOcclusionMask.size(), landmarks);
 
-        cv::Mat occlusionMask = mask.mul(1 - faceOcclusionMask);
-        double rawScore = cv::sum(occlusionMask).val[0] / cv::sum(mask).val[0];
+        double rawScore = mask.countDifference(faceOcclusionMask) / static_cast<double>(mask.countNonZero());
         double scalarScore = round(100 * (1 - rawScore));
         if (scalarScore < 0)
         {
@@ -64,6 +62,6 @@ namespace OFIQ_LIB::modules::measures
         {
             scalarScore = 100;
         }
-        session.assessment().qAssessments[qualityMeasure] = { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure, { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success });
     }
 }
\ No newline at end of file
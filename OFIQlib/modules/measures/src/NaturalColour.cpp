@@ -94,7 +94,8 @@ namespace OFIQ_LIB::modules::measures
         cv::Mat faceSegmentation;
         cv::bitwise_and(alignedFace, alignedFace, faceSegmentation, cvMask);
 
-        cv::Mat maskedImage = CreateMaskedImage(landmarks, faceSegmentation);
+        auto faceMask = FaceMeasures::GetCachedFaceMask(session, landmarks, faceSegmentation.rows, faceSegmentation.cols);
+        cv::Mat maskedImage = CreateMaskedImage(faceMask, faceSegmentation);
         OFIQ::LandmarkPoint leftEyeCenter;
         OFIQ::LandmarkPoint rightEyeCenter;
         double interEyeDistance;
@@ -117,11 +118,11 @@ namespace OFIQ_LIB::modules::measures
         SetQualityMeasure(session, qualityMeasure, rawScore, OFIQ::QualityMeasureReturnCode::Success);
     }
 
-    cv::Mat NaturalColour::CreateMaskedImage(const OFIQ::FaceLandmarks& landmarks, const cv::Mat& cvImage) const
+    cv::Mat NaturalColour::CreateMaskedImage(const RoiMask& faceMask, const cv::Mat& cvImage) const
     {
-        auto cvMask = FaceMeasures::GetFaceMask(landmarks, cvImage.rows, cvImage.cols);
-        cv::Mat maskedImage;
-        cvImage.copyTo(maskedImage, cvMask);
+        cv::Mat maskedImage = cv::Mat::zeros(cvImage.size(), cvImage.type());
+        if (!faceMask.empty())
+            cvImage(faceMask.roi()).copyTo(maskedImage(faceMask.roi()), faceMask.data());
         return maskedImage;
     }
 
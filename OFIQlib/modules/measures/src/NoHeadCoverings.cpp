@@ -26,7 +26,6 @@
 
 #include "NoHeadCoverings.h"
 #include "segmentations.h"
-#include <opencv2/imgproc.hpp>
 
 namespace OFIQ_LIB::modules::measures
 {
@@ -55,28 +54,19 @@ namespace OFIQ_LIB::modules::measures
 
     void NoHeadCoverings::Execute(OFIQ_LIB::Session & session)
     {
-        cv::Mat M = session.getFaceParsingImage();
+        // Crop the face parsing map M from the bottom by 204 pixels
+        const auto& M = session.faceParsingImage();
+        const int croppedRows = M.rows - 204;
 
-        // Crop M from the bottom by 204 pixels
-        cv::Rect rect(0, 0, M.cols, M.rows - 204);
-        cv::Mat croppedImage = M(rect);
-
-        // Count the number n of pixels in M having value 16 or 18
-        cv::Mat mask;
-        cv::Mat clothMask;
-        cv::Mat hatMask;
-        // set all values above and below Segment::cloth to 0
-        cv::threshold(croppedImage, mask, static_cast<uchar>(Segment::cloth) - 1, 255, cv::THRESH_TOZERO);
-        cv::threshold(mask, clothMask, static_cast<uchar>(Segment::cloth), 255, cv::THRESH_TOZERO_INV);
-        // set all values above and below Segment::hat to 0
-        cv::threshold(mask, hatMask, static_cast<uchar>(Segment::hat) - 1, 255, cv::THRESH_TOZERO);
-        cv::threshold(hatMask, hatMask, static_cast<uchar>(Segment::hat), 255, cv::THRESH_TOZERO_INV);
-        auto clothPixels = cv::countNonZero(clothMask);
-        auto hatPixels = cv::countNonZero(hatMask);
+        // Count the number n of pixels in M having value 16 or 18, taken from the
+        // class counts computed together with the face parsing
+        const auto& classCounts = session.getFaceParsingClassCounts();
+        auto clothPixels = classCounts.count(static_cast<int>(Segment::cloth), 0, croppedRows);
+        auto hatPixels = classCounts.count(static_cast<int>(Segment::hat), 0, croppedRows);
 
         // Output n/m where m is the number of pixels in M
         auto nonZeroPixels = clothPixels + hatPixels;
-        auto totalPixels = croppedImage.size().area();
+        auto totalPixels = cv::Size(M.cols, croppedRows).area();
         double rawScore = nonZeroPixels / (double)totalPixels;
 
         double scalarScore = 0.0;
@@ -101,6 +91,6 @@ namespace OFIQ_LIB::modules::measures
             scalarScore = round(100.0 * q);
         }
 
-        session.assessment().qAssessments[qualityMeasure] = { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure, { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success });
     }
 }
@@ -51,7 +51,7 @@ namespace OFIQ_LIB::modules::measures
 
         if (std::isnan(rawScore))
         {
-            session.assessment().qAssessments[qualityMeasure] = { rawScore,-1,OFIQ::QualityMeasureReturnCode::FailureToAssess };
+            session.qualityResults().set(qualityMeasure, { rawScore,-1,OFIQ::QualityMeasureReturnCode::FailureToAssess });
             return;
         }
 
@@ -64,7 +64,7 @@ namespace OFIQ_LIB::modules::measures
         {
             scalarScore = 100;
         }
-        session.assessment().qAssessments[qualityMeasure] = 
-            { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure,
+            { rawScore, scalarScore, OFIQ::QualityMeasureReturnCode::Success });
     }
 }
@@ -94,30 +94,33 @@ namespace OFIQ_LIB::modules::measures
     }
 
     void Sharpness::GetCroppedImages(
-        const Session& session,
+        Session& session,
         cv::Mat& faceCrop,
         cv::Mat& maskCrop,
         bool useAligned,
         float faceRegionAlpha) const
     {
-        cv::Mat img;
-        cv::Mat faceMask;
         if (useAligned)
         {
-            img = session.getAlignedFace();
-            faceMask = session.getAlignedFaceLandmarkedRegion() * 255;
+            cv::Mat img = session.getAlignedFace();
+            cv::Mat faceMask = session.getAlignedFaceLandmarkedRegion() * 255;
+            std::vector<std::vector<cv::Point>> contours;
+            cv::findContours(faceMask, contours, cv::RETR_TREE, cv::CHAIN_APPROX_SIMPLE);
+            cv::Rect rect = cv::boundingRect(contours[0]);
+            faceCrop = img(rect);
+            maskCrop = faceMask(rect);
         }
         else
         {
-            img = copyToCvImage(session.image());
+            // the mask is non-zero only inside its region of interest,
+            // which is the bounding box of the convex hull
+            const cv::Mat& img = session.getImageBGR();
             auto faceLandmarks = session.getLandmarks();
-            faceMask = landmarks::FaceMeasures::GetFaceMask(faceLandmarks, img.rows, img.cols, faceRegionAlpha) * 255;
+            auto faceMask = landmarks::FaceMeasures::GetCachedFaceMask(
+                session, faceLandmarks, img.rows, img.cols, faceRegionAlpha);
+            faceCrop = img(faceMask.roi());
+            maskCrop = faceMask.data() * 255;
         }
-        std::vector<std::vector<cv::Point>> contours;
-        cv::findContours(faceMask, contours, cv::RETR_TREE, cv::CHAIN_APPROX_SIMPLE);
-        cv::Rect rect = cv::boundingRect(contours[0]);
-        faceCrop = img(rect);
-        maskCrop = faceMask(rect);
     }
 
     cv::Mat Sharpness::GetClassifierFocusFeatures(const cv::Mat& image, const cv::Mat& mask, bool applyBlur) const
@@ -85,7 +85,7 @@ namespace OFIQ_LIB::modules::measures
         }
 
         float qc = round(100.0f * (1.0f - f));
-        session.assessment().qAssessments[qualityMeasure] = 
-            { static_cast<double>(f), static_cast<double>(qc), OFIQ::QualityMeasureReturnCode::Success };
+        session.qualityResults().set(qualityMeasure,
+            { static_cast<double>(f), static_cast<double>(qc), OFIQ::QualityMeasureReturnCode::Success });
     }
 }
\ No newline at end of file
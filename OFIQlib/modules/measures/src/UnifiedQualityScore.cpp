@@ -25,6 +25,7 @@
  */
 
 #include "UnifiedQualityScore.h"
+#include "GeometryPlan.h"
 #include "utils.h"
 #include "OFIQError.h"
 #include <opencv2/imgproc.hpp>
@@ -63,6 +64,7 @@ namespace OFIQ_LIB::modules::measures
                 (std::istreambuf_iterator<char>(instream)),
                 std::istreambuf_iterator<char>());
             m_onnxRuntimeEnv.initialize(modelData, imageSize,imageSize); 
+            m_directWarp = GeometryPlan::IsDirectWarpEnabled(configuration);
         }
         catch (std::exception&)
         {
@@ -84,12 +86,22 @@ namespace OFIQ_LIB::modules::measures
 
     void UnifiedQualityScore::Execute(OFIQ_LIB::Session & session)
     {
-        cv::Mat alignedFaceBGR = session.getAlignedFace();
-
-        cv::resize(alignedFaceBGR, alignedFaceBGR, cv::Size(scaledWidth, scaledHeight));
-        cv::Mat alignedFaceCropBGR = alignedFaceBGR(
-            cv::Range(cropTop, scaledHeight - cropBottom),
-            cv::Range(cropLeft, scaledWidth - cropRight));
+        const cv::Rect crop(
+            cropLeft, cropTop, scaledWidth - cropLeft - cropRight, scaledHeight - cropTop - cropBottom);
+        cv::Mat alignedFaceCropBGR;
+        if (m_directWarp)
+        {
+            alignedFaceCropBGR = GeometryPlan::FromAlignedFace(session)
+                .resize(cv::Size(scaledWidth, scaledHeight))
+                .crop(crop)
+                .warp(session.getImageBGR());
+        }
+        else
+        {
+            cv::Mat alignedFaceBGR = session.getAlignedFace();
+            cv::resize(alignedFaceBGR, alignedFaceBGR, cv::Size(scaledWidth, scaledHeight));
+            alignedFaceCropBGR = alignedFaceBGR(crop);
+        }
         auto blob = CreateBlob(alignedFaceCropBGR);
         
         std::vector<float> net_input;
@@ -109,11 +109,18 @@ namespace OFIQ_LIB::modules::poseEstimators
         std::array<int64_t, 4> m_inputShape;
 
         /**
-         * @brief Crop face from image. Internally the passed bounding box will be transformed to a square region.
+         * @brief Planar input tensor of the CNN; allocated once with m_numberOfInputElements values
+         * and refilled for each image.
+         */
+        std::vector<float> m_inputTensor;
+
+        /**
+         * @brief Crop face from image and resize it to the input size of the CNN.
+         * Internally the passed bounding box will be transformed to a square region.
          * 
          * @param image Input image.
          * @param biggestFace Input region to be cropped.
-         * @return cv::Mat Cropped face region.
+         * @return cv::Mat Cropped face region resized to the input size of the CNN.
          */
         cv::Mat CropImage(const cv::Mat& image, const OFIQ::BoundingBox& biggestFace) const;
     };
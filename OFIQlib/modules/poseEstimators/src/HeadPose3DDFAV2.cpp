@@ -29,6 +29,7 @@
 #include "HeadPose3DDFAV2.h"
 #include "OFIQError.h"
 #include "FaceMeasures.h"
+#include "Interruption.h"
 #include "AllPoseEstimators.h"
 #include "utils.h"
 #include <fstream>
@@ -66,6 +67,7 @@ namespace OFIQ_LIB::modules::poseEstimators
             m_numberOfInputElements = m_expectedImageNumberOfChannels * m_expectedImageWidth * m_expectedImageHeight;
             // define shape
             m_inputShape = { 1, m_expectedImageNumberOfChannels, m_expectedImageHeight, m_expectedImageWidth };
+            m_inputTensor.resize(m_numberOfInputElements);
         }
         catch (const std::exception&)
         {
@@ -77,34 +79,19 @@ namespace OFIQ_LIB::modules::poseEstimators
 
     void HeadPose3DDFAV2::updatePose(OFIQ_LIB::Session& session, EulerAngle& pose)
     {
-        const auto cvImageBGR = copyToCvImage(session.image());
+        const cv::Mat& cvImageBGR = session.getImageBGR();
         auto biggestFace = session.getDetectedFaces()[0];
 
-        cv::Mat croppedImageBGR = CropImage(cvImageBGR, biggestFace);
+        cv::Mat resizedImage = CropImage(cvImageBGR, biggestFace);
 
-        cv::Mat resizedImage;
-        cv::resize(croppedImageBGR, resizedImage, cv::Size(static_cast<int>(m_expectedImageWidth), static_cast<int>(m_expectedImageHeight)), 0, 0, cv::INTER_LINEAR);
-        resizedImage.convertTo(resizedImage, CV_32FC3);
-        cv::Mat normalizedImageBGR;
-        normalizedImageBGR = resizedImage - cv::Scalar(127.5, 127.5, 127.5);
-        normalizedImageBGR /= cv::Scalar(128.0, 128.0, 128.0);
-
-        // hwc -> chw
-        auto channelSize = normalizedImageBGR.rows * normalizedImageBGR.cols;
-        std::vector<float> tensor(3 * channelSize);
-        for (int i = 0; i < channelSize; i++)
-        {
-            const cv::Point2i point(i % normalizedImageBGR.cols, i / normalizedImageBGR.cols);
-            const auto& pixel = normalizedImageBGR.at<cv::Vec3f>(point);
-            for (int j = 0; j < 3; j++)
-                tensor[i + j * channelSize] = pixel[j];
-        }
+        // hwc -> chw with (x - 127.5) / 128 normalization
+        packPlanarNormalized(resizedImage, 1.0f / 128.0f, -127.5f / 128.0f, m_inputTensor.data());
 
         // define Tensor
         auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
         auto inputTensor = Ort::Value::CreateTensor<float>(
             memory_info,
-            &tensor[0],
+            m_inputTensor.data(),
             m_numberOfInputElements,
             m_inputShape.data(),
             m_inputShape.size());
@@ -116,6 +103,7 @@ namespace OFIQ_LIB::modules::poseEstimators
         try
         {
             Ort::RunOptions runOptions;
+            Interruption::ScopedRun scopedRun(runOptions);
             results = m_ortSession->Run(runOptions, inputNames.data(), &inputTensor, 1, outputNames.data(), 1);
         }
         catch (Ort::Exception& e)
@@ -200,21 +188,14 @@ namespace OFIQ_LIB::modules::poseEstimators
         box.ytop = b;
         box.width = c - a;
         box.height = d - b;
-        cv::Mat paddedImage;
-        OFIQ::BoundingBox croppedBox;
-        Point2i translationVector;
-        OFIQ_LIB::makeSquareBoundingBoxWithPadding(box, image, paddedImage, croppedBox, translationVector);
-
-        // crop image
-        // Define the region of interest (ROI) for cropping
-        cv::Rect roi(
-            croppedBox.xleft,
-            croppedBox.ytop,
-            croppedBox.width,
-            croppedBox.height); // (x, y, width, height)
-
-        // Crop the image using the ROI
-        cv::Mat croppedImage = paddedImage(roi);
+        OFIQ::BoundingBox croppedBox = OFIQ_LIB::makeSquareBoundingBox(box);
+
+        // crop and resize in one step; parts outside the image are filled with black
+        cv::Mat croppedImage = OFIQ_LIB::cropAndResizeWithConstantBorder(
+            image,
+            croppedBox,
+            static_cast<int>(m_expectedImageWidth),
+            static_cast<int>(m_expectedImageHeight));
         return croppedImage;
     }
 
@@ -99,10 +99,55 @@ namespace OFIQ_LIB::modules::segmentations
          * @brief Does the actual CNN-based occlusion-aware segmentation.
          * @param alignedImage Aligned image of dimension 616 x 616 as returned by 
          * \link OFIQ_LIB::Session::getAlignedFace() Session::getAlignedFace()\endlink.
-         * @return Image where a pixel belonging to non-occluded facial parts is 
-         * encoded as the byte value 1 and pixels belonging to other parts are encoded by the byte value 0.
+         * @param mask Receives an image of the size of <code>alignedImage</code> where a pixel belonging
+         * to non-occluded facial parts is encoded as the byte value 1 and pixels belonging to other parts
+         * are encoded by the byte value 0. Its buffer is reused if it already has that size.
          */
-        cv::Mat GetFaceOcclusionSegmentation(const cv::Mat& alignedImage);
+        void GetFaceOcclusionSegmentation(const cv::Mat& alignedImage, cv::Mat& mask);
+
+        /**
+         * @brief Does the CNN-based segmentation of a network input sampled directly from the input image.
+         * @details Used if \link OFIQ_LIB::GeometryPlan::IsDirectWarpEnabled() direct warp\endlink is
+         * enabled; the crop and resize steps of
+         * \link OFIQ_LIB::modules::segmentations::FaceOcclusionSegmentation::GetFaceOcclusionSegmentation()
+         * GetFaceOcclusionSegmentation()\endlink are composed with the alignment transformation.
+         * @param session Session providing the input image and the alignment transformation.
+         * @param mask Receives the mask as described for
+         * \link OFIQ_LIB::modules::segmentations::FaceOcclusionSegmentation::GetFaceOcclusionSegmentation()
+         * GetFaceOcclusionSegmentation()\endlink.
+         */
+        void GetFaceOcclusionSegmentationDirect(const OFIQ_LIB::Session& session, cv::Mat& mask);
+
+        /**
+         * @brief Runs the CNN on its input and writes the upscaled result into the mask.
+         * @param resized Network input of dimension <code>m_scaledWidth</code> x <code>m_scaledHeight</code> in BGR format.
+         * @param alignedSize Dimension of the aligned image and of <code>mask</code>.
+         * @param roi Cropped region of the aligned image the network input has been created from.
+         * @param mask Receives the mask.
+         */
+        void Segment(const cv::Mat& resized, const cv::Size& alignedSize, const cv::Rect& roi, cv::Mat& mask);
+
+        /**
+         * @brief Returns the region of the aligned image that is input to the CNN.
+         * @param alignedSize Dimension of the aligned image.
+         * @return Aligned image without the cropping borders.
+         */
+        cv::Rect CropRegion(const cv::Size& alignedSize) const;
+
+        /**
+         * @brief Thresholds the CNN output and writes it upscaled into the cropped region of a mask.
+         * @details Pixels with a non-negative logit are set to 1 and all others to 0. The upscaling
+         * selects source pixels as <code>cv::resize</code> with <code>cv::INTER_NEAREST</code> does.
+         * Pixels of <code>mask</code> outside <code>roi</code> are set to 0, such that every byte of
+         * the mask is written exactly once.
+         * @param logits CNN output of dimension <code>height</code> x <code>width</code>.
+         * @param width Width of the CNN output.
+         * @param height Height of the CNN output.
+         * @param roi Region of <code>mask</code> receiving the upscaled output.
+         * @param mask Matrix of type CV_8UC1 containing <code>roi</code>.
+         */
+        static void WriteUpscaledMask(
+            const float* logits, int width, int height, const cv::Rect& roi, cv::Mat& mask);
 
         /**
          * @brief Manages CNN computations.
@@ -156,5 +201,11 @@ namespace OFIQ_LIB::modules::segmentations
          */
         const int m_scaledHeight = 224;
 
+        /**
+         * @brief If true, the network input is sampled directly from the input image,
+         * see \link OFIQ_LIB::GeometryPlan GeometryPlan\endlink.
+         */
+        bool m_directWarp{false};
+
     };
 }
@@ -31,6 +31,7 @@
 #include "segmentations.h"
 
 #include <ONNXRTSegmentation.h>
+#include <vector>
 
  /**
   * @brief OpenCV's namespace.
@@ -96,6 +97,64 @@ namespace OFIQ_LIB::modules::segmentations
          */
         ~FaceParsing() override = default;
 
+        /**
+         * @brief Per-class pixel counts of the latest face parsing result.
+         * @details The counts are accumulated row by row in the argmax pass of
+         * \link OFIQ_LIB::modules::segmentations::FaceParsing::CalculateClassIds()
+         * CalculateClassIds()\endlink.
+         * @return Counts of the face parsing image returned for
+         * \link OFIQ_LIB::modules::segmentations::SegmentClassLabels::face SegmentClassLabels::face\endlink.
+         */
+        std::shared_ptr<const ClassCounts> GetClassCounts() const override { return m_classCounts; }
+
+        /**
+         * @brief Assigns each pixel the class with the highest score in the output of the
+         * face parsing CNN and returns the result.
+         * @details Is invoked by \link OFIQ_LIB::modules::segmentations::FaceParsing::SetImage()
+         * SetImage()\endlink. The argmax is computed in a single row-major pass directly on
+         * the output tensor of the CNN.
+         * @param scores Output tensor of the CNN in CHW layout, i.e. <code>nbChannels</code>
+         * planes of dimension <code>height</code> x <code>width</code>.
+         * @param nbChannels Number of classes; should be 19.
+         * @param height Height of the output; should be 400.
+         * @param width Width of the output; should be 400.
+         * @param classCounts Receives the number of pixels of each class, accumulated
+         * row by row while the class ids are assigned.
+         * @return Result of face parsing.
+         */
+        static std::shared_ptr<cv::Mat> CalculateClassIds(
+            const float* scores,
+            int nbChannels,
+            int height,
+            int width,
+            ClassCounts& classCounts);
+
+        /**
+         * @brief Creates the blob being input to the face parsing CNN.
+         * @param image Input image in RGB format
+         * @param i_imageSize_one_dim Specifies the size of the blob being
+         * input to the face parsing CNN; should be 400, such that a blob
+         * of dimension 400 x 400 is created.
+         * @return Blob of requested dimension.
+         */
+        static cv::Mat CreateBlob(const cv::Mat& image, int i_imageSize_one_dim);
+
+        /**
+         * @brief Creates the blob being input to the face parsing CNN without intermediate images.
+         * @details Resizing, normalization by the ImageNet mean and standard deviation,
+         * conversion from BGR to RGB and packing into planar layout are done in a single
+         * pass over the resized image. The normalized value of each 8 bit intensity is taken from a
+         * per-channel table, which is computed once by
+         * \link OFIQ_LIB::modules::segmentations::FaceParsing::CreateBlob() CreateBlob()\endlink;
+         * hence, the blob is bit-exact to the one of CreateBlob() for the RGB version of the image.
+         * @param image Input image in BGR format
+         * @param i_imageSize_one_dim Specifies the size of the blob being
+         * input to the face parsing CNN; should be 400, such that a blob
+         * of dimension 400 x 400 is created.
+         * @param blob Receives the blob of requested dimension in CHW layout.
+         */
+        static void CreateFusedBlob(const cv::Mat& image, int i_imageSize_one_dim, std::vector<float>& blob);
+
 
     protected:
         /**
@@ -140,6 +199,11 @@ namespace OFIQ_LIB::modules::segmentations
          */
         std::shared_ptr<cv::Mat> m_segmentationImage;
 
+        /**
+         * @brief Per-class pixel counts of \link m_segmentationImage\endlink.
+         */
+        std::shared_ptr<const ClassCounts> m_classCounts;
+
         /**
          * @brief JSON/JAXN key to access path to [BiSeNet](https://github.com/zllrunning/face-parsing.PyTorch)
          * model in ONNX format from
@@ -168,29 +232,28 @@ namespace OFIQ_LIB::modules::segmentations
         const int m_cropBottom = 60;
         
         /**
-         * @brief Creates the blob being input to the face parsing CNN.
-         * @param image Input image
-         * @param i_imageSize_one_dim Specifies the size of the blob being
-         * input to the face parsing CNN; should be 400, such that a blob
-         * of dimension 400 x 400 is created.
-         * @return Blob of requested dimension.
+         * @brief Input buffer of the face parsing CNN, reused between images by the fused pre-processing.
          */
-        static cv::Mat CreateBlob(const cv::Mat& image, int i_imageSize_one_dim);
+        std::vector<float> m_netInput;
 
         /**
-         * @brief Applies segmentation to the blob created from the input image
-         * and returns the result.
-         * @details Is invoked by \link OFIQ_LIB::modules::segmentations::FaceParsing::SetImage()
-         * SetImage()\endlink.
-         * @param resultImage Blob being created by one of the CreateBlob functions.
-         * @param i_imageSize_one_dim Specifies the size of the blob being
-         * input to the face parsing CNN; should be 400, such that a blob
-         * of dimension 400 x 400 is created.
-         * @return Result of face parsing.
+         * @brief JSON/JAXN key enabling the fused pre-processing of
+         * \link OFIQ_LIB::modules::segmentations::FaceParsing::CreateFusedBlob() CreateFusedBlob()\endlink.
          */
-        static std::shared_ptr<cv::Mat> CalculateClassIds(
-            const cv::Mat& resultImage,
-            int i_imageSize_one_dim);
+        const std::string m_fusedPreprocessingConfigItem = "params.measures.FaceParsing.fused_preprocessing";
+
+        /**
+         * @brief If true, the network input is created by
+         * \link OFIQ_LIB::modules::segmentations::FaceParsing::CreateFusedBlob() CreateFusedBlob()\endlink;
+         * otherwise by \link OFIQ_LIB::modules::segmentations::FaceParsing::CreateBlob() CreateBlob()\endlink.
+         */
+        bool m_fusedPreprocessing = true;
+
+        /**
+         * @brief If true, the network input is sampled directly from the input image,
+         * see \link OFIQ_LIB::GeometryPlan GeometryPlan\endlink.
+         */
+        bool m_directWarp = false;
 
         /*/
          * @brief Derives the private member \link segmentationImage\endlink
@@ -153,6 +153,15 @@ namespace OFIQ_LIB
         OFIQ::Image& GetMask(
             OFIQ_LIB::Session& session, modules::segmentations::SegmentClassLabels faceSegment);
 
+        /**
+         * @brief Per-class pixel counts of the label image computed by the latest call of
+         * \link UpdateMask() \endlink.
+         * @details Segmentations producing a label image may count the labels while creating it,
+         * such that measures do not have to scan the image again.
+         * @return Counts or null if not provided by the implementation.
+         */
+        virtual std::shared_ptr<const ClassCounts> GetClassCounts() const { return nullptr; }
+
     protected:
 
         /**
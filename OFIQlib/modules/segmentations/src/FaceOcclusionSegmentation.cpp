@@ -25,8 +25,10 @@
  */
 
 #include "FaceOcclusionSegmentation.h"
+#include "GeometryPlan.h"
 #include "OFIQError.h"
 #include "utils.h"
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <opencv2/imgcodecs.hpp>
@@ -39,6 +41,7 @@ namespace OFIQ_LIB::modules::segmentations
     FaceOcclusionSegmentation::FaceOcclusionSegmentation(const Configuration& config)
     {
         std::string modelPath = config.getDataDir() + "/" + config.GetString(m_modelConfigItem);
+        m_directWarp = GeometryPlan::IsDirectWarpEnabled(config);
 
         try
         {
@@ -57,16 +60,37 @@ namespace OFIQ_LIB::modules::segmentations
         }
     }
 
-    cv::Mat FaceOcclusionSegmentation::GetFaceOcclusionSegmentation(const cv::Mat& alignedImage)
+    cv::Rect FaceOcclusionSegmentation::CropRegion(const cv::Size& alignedSize) const
     {
-        cv::Mat alignedCrop = alignedImage(
-            cv::Range(m_cropTop, alignedImage.rows - m_cropBottom),
-            cv::Range(m_cropLeft, alignedImage.cols - m_cropRight));
-        int croppedWidth = alignedCrop.cols;
-        int croppedHeight = alignedCrop.rows;
-        cv::Size size(m_scaledWidth, m_scaledHeight);
+        return cv::Rect(
+            m_cropLeft,
+            m_cropTop,
+            alignedSize.width - m_cropLeft - m_cropRight,
+            alignedSize.height - m_cropTop - m_cropBottom);
+    }
+
+    void FaceOcclusionSegmentation::GetFaceOcclusionSegmentation(const cv::Mat& alignedImage, cv::Mat& mask)
+    {
+        const cv::Rect roi = CropRegion(alignedImage.size());
         cv::Mat resized;
-        cv::resize(alignedCrop, resized, size);
+        cv::resize(alignedImage(roi), resized, cv::Size(m_scaledWidth, m_scaledHeight));
+        Segment(resized, alignedImage.size(), roi, mask);
+    }
+
+    void FaceOcclusionSegmentation::GetFaceOcclusionSegmentationDirect(const OFIQ_LIB::Session& session, cv::Mat& mask)
+    {
+        const cv::Size alignedSize(GeometryPlan::alignedFaceSize, GeometryPlan::alignedFaceSize);
+        const cv::Rect roi = CropRegion(alignedSize);
+        cv::Mat resized = GeometryPlan::FromAlignedFace(session)
+            .crop(roi)
+            .resize(cv::Size(m_scaledWidth, m_scaledHeight))
+            .warp(session.getImageBGR());
+        Segment(resized, alignedSize, roi, mask);
+    }
+
+    void FaceOcclusionSegmentation::Segment(
+        const cv::Mat& resized, const cv::Size& alignedSize, const cv::Rect& roi, cv::Mat& mask)
+    {
         float scaleFactor = 1/255.0f;
         cv::Mat blob = cv::dnn::blobFromImage({resized}, scaleFactor, cv::Size(), 0, true);
 
@@ -83,35 +107,64 @@ namespace OFIQ_LIB::modules::segmentations
         std::vector<int64_t> shape = element.GetShape();
         auto elementPtr = results[useThisOutput].GetTensorMutableData<float>();
 
-        // Assuming 'tensorDims' contains dimensions like {batchSize, channels, height, width}
-        auto batchSize = static_cast<int>(shape[0]);
-        auto nbChannels = static_cast<int>(shape[1]);
+        // Assuming 'tensorDims' contains dimensions like {batchSize, channels, height, width};
+        // the mask is taken from the first channel of the first image of the batch
         auto height = static_cast<int>(shape[2]);
         auto width = static_cast<int>(shape[3]);
 
-        // Create a cv::Mat from the tensor data
-        std::array<int, 4> sizeMat = { batchSize, nbChannels, height, width };
-        auto mat = cv::Mat(4, sizeMat.data(), CV_32FC1, elementPtr);
-
-        cv::Mat outputReshaped(size, CV_32F, elementPtr);
-
-        outputReshaped *= -1;
-        cv::threshold(outputReshaped, outputReshaped, 0, 1, cv::THRESH_BINARY_INV);
-        cv::Mat maskRescaled;
-        cv::resize(
-            outputReshaped,
-            maskRescaled,
-            cv::Size(croppedWidth, croppedHeight),
-            0,
-            0,
-            cv::INTER_NEAREST);
-        cv::Mat maskAligned = cv::Mat::zeros(alignedImage.size(), CV_64F);
-        maskRescaled.copyTo(maskAligned(
-            cv::Range(m_cropTop, croppedHeight + m_cropTop),
-            cv::Range(m_cropLeft, croppedWidth + m_cropLeft)));
-        maskAligned.convertTo(maskAligned, CV_8U);
-
-        return maskAligned;
+        mask.create(alignedSize, CV_8U);
+        WriteUpscaledMask(
+            elementPtr,
+            width,
+            height,
+            roi,
+            mask);
+    }
+
+    void FaceOcclusionSegmentation::WriteUpscaledMask(
+        const float* logits, int width, int height, const cv::Rect& roi, cv::Mat& mask)
+    {
+        // threshold the logits once: occluded pixels have negative logits
+        std::vector<uchar> binary(static_cast<size_t>(width) * height);
+        for (size_t i = 0; i < binary.size(); i++)
+            binary[i] = logits[i] < 0 ? 0 : 1;
+
+        // source columns of the target columns, computed as by cv::INTER_NEAREST
+        const double inverseScaleX = 1.0 / (static_cast<double>(roi.width) / width);
+        const double inverseScaleY = 1.0 / (static_cast<double>(roi.height) / height);
+        std::vector<int> sourceColumns(roi.width);
+        for (int x = 0; x < roi.width; x++)
+            sourceColumns[x] = std::min(cvFloor(x * inverseScaleX), width - 1);
+
+        int previousSourceRow = -1;
+        const uchar* previousRow = nullptr;
+        for (int y = 0; y < mask.rows; y++)
+        {
+            auto* row = mask.ptr<uchar>(y);
+            if (y < roi.y || y >= roi.y + roi.height)
+            {
+                std::fill(row, row + mask.cols, uchar{0});
+                continue;
+            }
+
+            std::fill(row, row + roi.x, uchar{0});
+            std::fill(row + roi.x + roi.width, row + mask.cols, uchar{0});
+
+            uchar* target = row + roi.x;
+            const int sourceRow = std::min(cvFloor((y - roi.y) * inverseScaleY), height - 1);
+            if (sourceRow == previousSourceRow)
+            {
+                // consecutive target rows mapping to the same source row are identical
+                std::copy(previousRow, previousRow + roi.width, target);
+                continue;
+            }
+
+            const uchar* source = binary.data() + static_cast<size_t>(sourceRow) * width;
+            for (int x = 0; x < roi.width; x++)
+                target[x] = source[sourceColumns[x]];
+            previousSourceRow = sourceRow;
+            previousRow = target;
+        }
     }
 
     OFIQ::Image FaceOcclusionSegmentation::UpdateMask(
@@ -120,8 +173,12 @@ namespace OFIQ_LIB::modules::segmentations
         if (m_segmentationImage == nullptr || session.Id() != GetLastSessionId())
             try
             {
-                m_segmentationImage =
-                    std::make_shared<cv::Mat>(GetFaceOcclusionSegmentation(session.getAlignedFace()));
+                if (m_segmentationImage == nullptr)
+                    m_segmentationImage = std::make_shared<cv::Mat>();
+                if (m_directWarp)
+                    GetFaceOcclusionSegmentationDirect(session, *m_segmentationImage);
+                else
+                    GetFaceOcclusionSegmentation(session.getAlignedFace(), *m_segmentationImage);
             }
             catch (const std::exception& e)
             {
@@ -25,8 +25,11 @@
  */
 
 #include "FaceParsing.h"
+#include "GeometryPlan.h"
 #include "OFIQError.h"
 #include "utils.h"
+#include <algorithm>
+#include <array>
 #include <string>
 #include <fstream>
 #include <opencv2/opencv.hpp>
@@ -39,6 +42,9 @@ namespace OFIQ_LIB::modules::segmentations
     FaceParsing::FaceParsing(const Configuration& config)
     {
         std::string modelPath = config.getDataDir() + "/" + config.GetString(m_modelConfigItem);
+        if (!config.GetBool(m_fusedPreprocessingConfigItem, m_fusedPreprocessing))
+            m_fusedPreprocessing = true;
+        m_directWarp = GeometryPlan::IsDirectWarpEnabled(config);
         
         try
         {
@@ -61,18 +67,37 @@ namespace OFIQ_LIB::modules::segmentations
 
     void FaceParsing::SetImage(const OFIQ_LIB::Session& session)
     {
-        cv::Mat inputImage = session.getAlignedFace();
-        cv::Mat croppedImage = inputImage(
-            cv::Range(0, inputImage.rows - m_cropBottom), 
-            cv::Range(m_cropLeft, inputImage.cols - m_cropRight));
-        cv::cvtColor(croppedImage, croppedImage, cv::COLOR_BGR2RGB);
-        auto blob = FaceParsing::CreateBlob(croppedImage, m_imageSize);
-
-        // Convert cv::Mat to std::vector<float>
-        std::vector<float> net_input;
-        net_input.assign(blob.begin<float>(), blob.end<float>());
-
-        auto results = m_onnxRuntimeEnv.run(net_input);
+        cv::Mat croppedImage;
+        if (m_directWarp)
+        {
+            // the crop is resampled to the network input size, which is then kept by the blob creation
+            const int alignedSize = GeometryPlan::alignedFaceSize;
+            croppedImage = GeometryPlan::FromAlignedFace(session)
+                .crop(cv::Rect(m_cropLeft, 0, alignedSize - m_cropLeft - m_cropRight, alignedSize - m_cropBottom))
+                .resize(cv::Size(m_imageSize, m_imageSize))
+                .warp(session.getImageBGR());
+        }
+        else
+        {
+            cv::Mat inputImage = session.getAlignedFace();
+            croppedImage = inputImage(
+                cv::Range(0, inputImage.rows - m_cropBottom), 
+                cv::Range(m_cropLeft, inputImage.cols - m_cropRight));
+        }
+        if (m_fusedPreprocessing)
+        {
+            FaceParsing::CreateFusedBlob(croppedImage, m_imageSize, m_netInput);
+        }
+        else
+        {
+            cv::cvtColor(croppedImage, croppedImage, cv::COLOR_BGR2RGB);
+            auto blob = FaceParsing::CreateBlob(croppedImage, m_imageSize);
+
+            // Convert cv::Mat to std::vector<float>
+            m_netInput.assign(blob.begin<float>(), blob.end<float>());
+        }
+
+        auto results = m_onnxRuntimeEnv.run(m_netInput);
         
         size_t useThisOutput = 0;
 
@@ -80,22 +105,20 @@ namespace OFIQ_LIB::modules::segmentations
         std::vector<int64_t> shape = element.GetShape();
         auto elementPtr = results[useThisOutput].GetTensorMutableData<float>();
     
-        // Assuming 'tensorDims' contains dimensions like {batchSize, channels, height, width}
-        auto batchSize = static_cast<int>(shape[0]);
+        // Assuming 'tensorDims' contains dimensions like {batchSize, channels, height, width};
+        // the class ids are computed from the first image of the batch directly on the tensor data
         auto nbChannels = static_cast<int>(shape[1]);
         auto height = static_cast<int>(shape[2]);
         auto width = static_cast<int>(shape[3]);
 
-        // Create a cv::Mat from the tensor data
-        std::array<int, 4> size = { batchSize, nbChannels, height, width };
-        auto mat = cv::Mat(4, size.data(), CV_32FC1, elementPtr);
-        
-        std::vector<cv::Mat> out;
-        cv::dnn::imagesFromBlob(mat, out);
-
+        auto classCounts = std::make_shared<ClassCounts>(height);
         m_segmentationImage = FaceParsing::CalculateClassIds(
-            out[0],
-            m_imageSize);
+            elementPtr,
+            nbChannels,
+            height,
+            width,
+            *classCounts);
+        m_classCounts = std::move(classCounts);
 
     }
 
@@ -159,34 +182,91 @@ namespace OFIQ_LIB::modules::segmentations
         return blob;
     }
 
-    std::shared_ptr<cv::Mat> FaceParsing::CalculateClassIds(
-        const cv::Mat& resultImage, int imageSize_one_dim)
+    void FaceParsing::CreateFusedBlob(const cv::Mat& image, int imageSize, std::vector<float>& blob)
     {
+        // Normalized value of every 8 bit intensity per RGB channel, as computed by CreateBlob.
+        // The normalization is applied element-wise, so looking the values up reproduces
+        // the rounding of CreateBlob exactly, which folding it into one scale and bias does not.
+        static const auto normalized = []
+        {
+            // 16 x 16 pixels hold all 8 bit values, such that CreateBlob does not resize the image
+            constexpr int tableDim = 16;
+            cv::Mat intensities(tableDim, tableDim, CV_8UC3);
+            for (int value = 0; value < 256; value++)
+                intensities.at<cv::Vec3b>(value / tableDim, value % tableDim) = cv::Vec3b::all(static_cast<uchar>(value));
+
+            const cv::Mat values = FaceParsing::CreateBlob(intensities, tableDim);
+            const auto* planes = values.ptr<float>();
+            std::array<std::array<float, 256>, 3> table;
+            for (size_t c = 0; c < table.size(); c++)
+                std::copy(planes + c * 256, planes + (c + 1) * 256, table[c].begin());
+            return table;
+        }();
+
+        // same interpolation as cv::dnn::blobFromImage
+        cv::Mat resized;
+        cv::resize(image, resized, cv::Size(imageSize, imageSize), 0, 0, cv::INTER_LINEAR);
 
-        cv::Mat1f maxValues(cv::Size(imageSize_one_dim, imageSize_one_dim), -5000.0);
-        auto output = cv::Mat1b(cv::Size(imageSize_one_dim, imageSize_one_dim), 25);
-        std::vector<cv::Mat> channels;
+        // pack the BGR interleaved image into RGB planes
+        const auto& normalizedR = normalized[0];
+        const auto& normalizedG = normalized[1];
+        const auto& normalizedB = normalized[2];
+        const size_t planeSize = static_cast<size_t>(imageSize) * imageSize;
+        blob.resize(3 * planeSize);
+        float* planeR = blob.data();
+        float* planeG = planeR + planeSize;
+        float* planeB = planeG + planeSize;
+        for (int y = 0; y < imageSize; y++)
+        {
+            const auto* pixel = resized.ptr<uchar>(y);
+            const size_t offset = static_cast<size_t>(y) * imageSize;
+            for (int x = 0; x < imageSize; x++, pixel += 3)
+            {
+                planeB[offset + x] = normalizedB[pixel[0]];
+                planeG[offset + x] = normalizedG[pixel[1]];
+                planeR[offset + x] = normalizedR[pixel[2]];
+            }
+        }
+    }
 
-        cv::split(resultImage, channels);
+    std::shared_ptr<cv::Mat> FaceParsing::CalculateClassIds(
+        const float* scores, int nbChannels, int height, int width, ClassCounts& classCounts)
+    {
+        // pixels whose scores never exceed the initial maximum keep the
+        // label 25, which does not correspond to any class
+        constexpr float initialMaxValue = -5000.0f;
+        constexpr uchar initialClassId = 25;
 
-        #define FOREACHPIXEL for (int i = 0; i < imageSize_one_dim; i++) for (int j = 0; j < imageSize_one_dim; j++)
+        auto output = std::make_shared<cv::Mat>(height, width, CV_8UC1);
+        std::vector<float> maxValues(width);
+        const size_t planeSize = static_cast<size_t>(height) * width;
 
-        for (uchar channelId = 0; channelId < channels.size(); channelId++)
+        // Row-major argmax: for each row the channel rows are visited one after
+        // another, so that all accesses are contiguous and the inner loop vectorizes.
+        // Ties are resolved in favour of the lowest channel id.
+        for (int y = 0; y < height; y++)
         {
-            auto& channel = channels[channelId];
-            FOREACHPIXEL
+            auto* classIds = output->ptr<uchar>(y);
+            std::fill(maxValues.begin(), maxValues.end(), initialMaxValue);
+            std::fill(classIds, classIds + width, initialClassId);
+
+            const float* channelRow = scores + static_cast<size_t>(y) * width;
+            for (int channelId = 0; channelId < nbChannels; channelId++, channelRow += planeSize)
             {
-                auto value = channel.at<float>(cv::Point(i, j));
-                auto& maxValue = maxValues.at<float>(cv::Point(i, j));
-                if (value > maxValue)
+                const auto id = static_cast<uchar>(channelId);
+                for (int x = 0; x < width; x++)
                 {
-                    maxValue = value;
-                    output.at<uchar>(cv::Point(i, j)) = channelId;
+                    const bool isGreater = channelRow[x] > maxValues[x];
+                    maxValues[x] = isGreater ? channelRow[x] : maxValues[x];
+                    classIds[x] = isGreater ? id : classIds[x];
                 }
             }
+
+            // the row is still in cache, count its classes for the measures
+            classCounts.addRow(y, classIds, width);
         }
 
-        return std::make_shared<cv::Mat>(output);
+        return output;
     }
 
-}
\ No newline at end of file
+}
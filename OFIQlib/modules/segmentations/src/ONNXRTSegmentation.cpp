@@ -26,6 +26,7 @@
 
 #include <ONNXRTSegmentation.h>
 #include "OFIQError.h"
+#include "Interruption.h"
 
 void ONNXRuntimeSegmentation::initialize(
     const std::vector<uint8_t>& i_modelData, int64_t i_imageWidth, int64_t i_imageHeight)
@@ -77,6 +78,7 @@ std::vector<Ort::Value> ONNXRuntimeSegmentation::run( std::vector<float>& i_netI
 
     // run inference
     Ort::RunOptions runOptions;
+    OFIQ_LIB::Interruption::ScopedRun scopedRun(runOptions);
     results = m_ortSession->Run(
         runOptions,
         inputNames.data(),
@@ -0,0 +1,124 @@
+/**
+ * @file ClassCounts.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Per-class and per-row pixel counts of a label image such as the face parsing.
+ * @author OFIQ development team
+ */
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * Namespace for OFIQ implementations.
+ */
+namespace OFIQ_LIB
+{
+    /**
+     * @brief Pixel counts of each label of a label image, accumulated row by row.
+     * @details Measures based on the face parsing mostly ask how many pixels of a class
+     * lie in a band of rows, e.g. NoHeadCoverings counts cloth and hat pixels above
+     * the bottom margin. The counts are stored as prefix sums over rows, such that
+     * the number of pixels of a label in any range of rows is a single subtraction.
+     * They are filled while the label image is created and no further pass over the image is required.
+     */
+    class ClassCounts
+    {
+    public:
+        /**
+         * @brief Number of distinct labels being counted.
+         * @details The face parsing assigns the labels 0 to 18 and 25 for pixels without class.
+         * Labels greater or equal than this number are not counted.
+         */
+        static constexpr int numberOfLabels = 26;
+
+        /**
+         * @brief Constructs empty counts.
+         */
+        ClassCounts() = default;
+
+        /**
+         * @brief Constructs zero counts for a label image with the given number of rows.
+         * @param rows Number of rows of the label image.
+         */
+        explicit ClassCounts(int rows);
+
+        /**
+         * @brief Counts the labels of a complete label image.
+         * @param labels Matrix of type CV_8UC1.
+         * @return Counts of all labels of <code>labels</code>.
+         */
+        static ClassCounts FromImage(const cv::Mat& labels);
+
+        /**
+         * @brief Adds the labels of one row.
+         * @details Rows have to be added in ascending order starting with row 0.
+         * @param y Index of the row.
+         * @param labels Pointer to the labels of the row.
+         * @param width Number of labels in the row.
+         */
+        void addRow(int y, const uchar* labels, int width);
+
+        /**
+         * @brief Number of rows the counts refer to.
+         * @return Number of rows.
+         */
+        int rows() const { return m_rows; }
+
+        /**
+         * @brief Checks whether no counts are available.
+         * @return true if the counts do not refer to any row.
+         */
+        bool empty() const { return m_rows == 0; }
+
+        /**
+         * @brief Number of pixels of a label in the whole image.
+         * @param label Label to be counted.
+         * @return Number of pixels; 0 for labels that are not counted.
+         */
+        int count(int label) const { return count(label, 0, m_rows); }
+
+        /**
+         * @brief Number of pixels of a label in the rows <code>[rowBegin, rowEnd)</code>.
+         * @details The row range is clipped to the rows the counts refer to.
+         * @param label Label to be counted.
+         * @param rowBegin First row (inclusive).
+         * @param rowEnd Last row (exclusive).
+         * @return Number of pixels; 0 for labels that are not counted.
+         */
+        int count(int label, int rowBegin, int rowEnd) const;
+
+    private:
+        /**
+         * @brief Number of rows the counts refer to.
+         */
+        int m_rows = 0;
+
+        /**
+         * @brief Prefix sums of the label counts of dimension <code>(m_rows + 1) x numberOfLabels</code>.
+         * @details Entry <code>y * numberOfLabels + label</code> is the number of pixels of <code>label</code>
+         * in the rows <code>[0, y)</code>.
+         */
+        std::vector<int> m_prefixCounts;
+    };
+}
@@ -28,8 +28,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 #include <filesystem>
 
 #include <tao/json/forward.hpp>
@@ -142,6 +144,24 @@ namespace OFIQ_LIB
          */
         void SetDataDir(std::string_view dataDir);
 
+        /**
+         * @brief Computes a hash of the library version, all configuration parameters and the configuration directory.
+         * @details For each parameter whose key ends in <code>_path</code>, size and modification time
+         * of the referenced model file are included as well, so that replacing a model changes the hash.
+         * Two configurations with the same hash produce the same quality assessments.
+         * @return Hash value computed by \link OFIQ_LIB::hashBytes() hashBytes()\endlink.
+         */
+        uint64_t GetHash() const;
+
+        /**
+         * @brief Computes the hash of \link GetHash() \endlink over the parameters whose keys start with one of
+         * the given prefixes only.
+         * @details Used for results that depend on a part of the configuration only, e.g. the pre-processing.
+         * @param keyPrefixes Prefixes of the keys to be included; an empty prefix includes all parameters.
+         * @return Hash value computed by \link OFIQ_LIB::hashBytes() hashBytes()\endlink.
+         */
+        uint64_t GetHash(const std::vector<std::string>& keyPrefixes) const;
+
     private:
         /**
          * @brief Map holding all configuration that can be accessed using a string key. 
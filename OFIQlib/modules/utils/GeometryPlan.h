@@ -0,0 +1,142 @@
+/**
+ * @file GeometryPlan.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Composition of alignment, cropping and resizing into a single affine transformation.
+ * @author OFIQ development team
+ */
+#pragma once
+
+#include "Configuration.h"
+#include "Session.h"
+#include "utils.h"
+#include <opencv2/opencv.hpp>
+
+/**
+ * Namespace for OFIQ implementations.
+ */
+namespace OFIQ_LIB
+{
+    /**
+     * @brief Plans the geometric transformation from the input image to the input of a CNN.
+     * @details The default pre-processing warps the input image to the aligned face image of
+     * dimension 616 x 616; the measures and segmentations crop and resize this image again.
+     * A geometry plan starts with the alignment transformation and composes the subsequent crop and
+     * resize operations into one affine transformation, such that the network input can be sampled
+     * from the input image in a single bilinear resampling pass.
+     * <br/><br/>
+     * This mode is opt-in (see \link IsDirectWarpEnabled \endlink). Resampling once from the input image
+     * does not reproduce the rounding and interpolation of the chained operations; the resulting scores
+     * can therefore deviate from the values in <code>data/tests/expected_results/expected_results.csv</code>.
+     * The deviation should be measured with the conformance test before enabling the mode; the measured
+     * deviation of the network inputs is listed in @ref sec_geometry_cfg.
+     */
+    class GeometryPlan
+    {
+    public:
+        /**
+         * @brief Dimension of the aligned face image as computed by \link OFIQ_LIB::alignImage alignImage \endlink.
+         */
+        static constexpr int alignedFaceSize = 616;
+
+        /**
+         * @brief Reads whether the direct warp mode is enabled.
+         * @param configuration Configuration object; the key <code>params.geometry.direct_warp</code> is evaluated.
+         * @return true if the network inputs shall be sampled directly from the input image; default is false.
+         */
+        static bool IsDirectWarpEnabled(const Configuration& configuration);
+
+        /**
+         * @brief Reads the method used to estimate the face alignment transformation.
+         * @param configuration Configuration object; the key <code>params.geometry.alignment</code> is evaluated.
+         * Valid values are <code>"LMEDS"</code> and <code>"Umeyama"</code>.
+         * @return Configured alignment method; default is \link AlignmentMethod::LMEDS \endlink.
+         * @throws OFIQError if the configured value is unknown.
+         */
+        static AlignmentMethod GetAlignmentMethod(const Configuration& configuration);
+
+        /**
+         * @brief Creates a plan mapping the input image to the aligned face image.
+         * @param session Session whose alignment transformation matrix is used.
+         * @return Plan whose target is the aligned face image of dimension 616 x 616.
+         */
+        static GeometryPlan FromAlignedFace(const Session& session);
+
+        /**
+         * @brief Constructor
+         * @param transform Affine 2 x 3 transformation from source to target coordinates.
+         * @param size Dimension of the target.
+         */
+        GeometryPlan(const cv::Matx23d& transform, const cv::Size& size);
+
+        /**
+         * @brief Appends cropping the current target.
+         * @param roi Region in coordinates of the current target.
+         * @return Reference to this plan.
+         */
+        GeometryPlan& crop(const cv::Rect& roi);
+
+        /**
+         * @brief Appends resizing the current target with the pixel-centre convention of cv::resize.
+         * @param size New dimension of the target.
+         * @return Reference to this plan.
+         */
+        GeometryPlan& resize(const cv::Size& size);
+
+        /**
+         * @brief Samples the target from the source image using bilinear interpolation.
+         * @details Pixels mapped outside the source image are set to black.
+         * @param source Source image, usually \link OFIQ_LIB::Session::getImageBGR() Session::getImageBGR()\endlink.
+         * @return Target image of dimension \link size() \endlink.
+         */
+        cv::Mat warp(const cv::Mat& source) const;
+
+        /**
+         * @brief Affine transformation from source to target coordinates.
+         * @return The transformation matrix.
+         */
+        const cv::Matx23d& transform() const { return m_transform; }
+
+        /**
+         * @brief Dimension of the target.
+         * @return The dimension.
+         */
+        const cv::Size& size() const { return m_size; }
+
+    private:
+        /**
+         * @brief Affine transformation from source to target coordinates.
+         */
+        cv::Matx23d m_transform;
+
+        /**
+         * @brief Dimension of the target.
+         */
+        cv::Size m_size;
+
+        /**
+         * @brief Composes the current transformation with <code>next</code>.
+         * @param next Transformation applied after the current one.
+         */
+        void compose(const cv::Matx23d& next);
+    };
+}
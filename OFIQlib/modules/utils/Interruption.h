@@ -0,0 +1,204 @@
+/**
+ * @file Interruption.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Aborting assessments on cancellation or when their deadline has passed.
+ * @author OFIQ development team
+ */
+#pragma once
+
+#include "ofiq_lib.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief ONNX Runtime's namespace.
+ */
+namespace Ort
+{
+    /**
+     * @brief Forward declaration of the ONNX Runtime class Ort::RunOptions.
+     */
+    struct RunOptions;
+}
+
+/**
+ * Namespace for OFIQ implementations.
+ */
+namespace OFIQ_LIB
+{
+    /**
+     * @brief Observes the cancellation token and the deadline of an assessment.
+     * @details While an object exists, it is the current interruption of the thread that created it,
+     * see \link Current \endlink. ONNX Runtime inferences run on that thread register their run options
+     * with a \link ScopedRun \endlink object; a watchdog thread terminates the registered inference as
+     * soon as the token is cancelled or the deadline has passed. Between inferences, the assessment
+     * checks \link isInterrupted \endlink before each pre-processing stage and each measure.
+     */
+    class Interruption
+    {
+    public:
+        /**
+         * @brief Registers the run options of an inference with the current interruption of the thread.
+         * @details If the assessment is already interrupted, the inference is terminated right away.
+         * Does nothing if the thread has no current interruption.
+         */
+        class ScopedRun
+        {
+        public:
+            /**
+             * @brief Constructor
+             * @param runOptions Run options passed to the inference.
+             */
+            explicit ScopedRun(Ort::RunOptions& runOptions);
+
+            /**
+             * @brief Destructor; unregisters the run options.
+             */
+            ~ScopedRun();
+
+            /**
+             * @brief Copying is not supported.
+             */
+            ScopedRun(const ScopedRun&) = delete;
+
+            /**
+             * @brief Copying is not supported.
+             * @return Reference to this object.
+             */
+            ScopedRun& operator=(const ScopedRun&) = delete;
+
+        private:
+            /**
+             * @brief Current interruption of the thread when the object was created; may be null.
+             */
+            Interruption* m_interruption;
+        };
+
+        /**
+         * @brief Constructor; makes the object the current interruption of the calling thread.
+         * @details A watchdog thread is only started if a token or a deadline is given.
+         * @param cancellation Token and deadline aborting the assessment.
+         */
+        explicit Interruption(const OFIQ::AssessmentCancellation& cancellation);
+
+        /**
+         * @brief Destructor; stops the watchdog and restores the previous interruption of the thread.
+         */
+        ~Interruption();
+
+        /**
+         * @brief Copying is not supported.
+         */
+        Interruption(const Interruption&) = delete;
+
+        /**
+         * @brief Copying is not supported.
+         * @return Reference to this object.
+         */
+        Interruption& operator=(const Interruption&) = delete;
+
+        /**
+         * @brief Checks whether the token has been cancelled or the deadline has passed.
+         * @return true if the assessment has to be aborted.
+         */
+        bool isInterrupted() const;
+
+        /**
+         * @brief Reason of an interruption.
+         * @return \link OFIQ::ReturnCode::Cancelled ReturnCode::Cancelled\endlink if the token has been
+         * cancelled, otherwise \link OFIQ::ReturnCode::DeadlineExceeded ReturnCode::DeadlineExceeded\endlink.
+         */
+        OFIQ::ReturnCode reason() const;
+
+        /**
+         * @brief Interruption of the calling thread.
+         * @return Most recently created interruption of the calling thread that still exists; may be null.
+         */
+        static Interruption* Current();
+
+    private:
+        /**
+         * @brief Loop of the watchdog thread terminating the registered inference once interrupted.
+         */
+        void Watch();
+
+        /**
+         * @brief Registers the run options of an inference; terminates it if already interrupted.
+         * @param runOptions Run options of the inference.
+         */
+        void Register(Ort::RunOptions& runOptions);
+
+        /**
+         * @brief Unregisters the run options of the finished inference.
+         */
+        void Unregister();
+
+        /**
+         * @brief Interval in which the watchdog checks the token.
+         */
+        static constexpr std::chrono::milliseconds pollInterval{5};
+
+        /**
+         * @brief Token aborting the assessment; may be null.
+         */
+        std::shared_ptr<const OFIQ::CancellationToken> m_token;
+
+        /**
+         * @brief Point in time at which the assessment is aborted.
+         */
+        std::chrono::steady_clock::time_point m_deadline;
+
+        /**
+         * @brief Interruption of the thread before this object was created.
+         */
+        Interruption* m_previous;
+
+        /**
+         * @brief Guards the registered run options and the stopping flag.
+         */
+        std::mutex m_mutex;
+
+        /**
+         * @brief Signalled when the watchdog is stopped.
+         */
+        std::condition_variable m_stop;
+
+        /**
+         * @brief Set when the watchdog is stopped.
+         */
+        bool m_stopping = false;
+
+        /**
+         * @brief Run options of the running inference; null between inferences.
+         */
+        Ort::RunOptions* m_activeRun = nullptr;
+
+        /**
+         * @brief Watchdog thread; not started without token and deadline.
+         */
+        std::thread m_watchdog;
+    };
+}
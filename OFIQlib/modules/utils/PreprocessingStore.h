@@ -0,0 +1,163 @@
+/**
+ * @file PreprocessingStore.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Persistent store of pre-processing artifacts for re-scoring images.
+ * @author OFIQ development team
+ */
+#pragma once
+
+#include "Configuration.h"
+#include "Session.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Namespace for OFIQ implementations.
+ */
+namespace OFIQ_LIB
+{
+    /**
+     * @brief Writes the pre-processing artifacts of sessions to a directory and loads them again.
+     * @details In \link Mode::Write \endlink mode, the face geometry (detected faces, landmarks, pose,
+     * alignment transformation and aligned landmarks) and the segmentations (face parsing
+     * and face occlusion mask) of each assessed image are written to one binary file per image. In
+     * \link Mode::Read \endlink mode, these artifacts replace the pre-processing networks, such that
+     * re-scoring an archive with changed measure parameters runs the measures only. Files are named by a hash
+     * of the image content; masks are stored PNG-compressed. Each file records the hash of the configuration
+     * of the pre-processing; files written with a different configuration are not loaded.
+     * @see @ref sec_preprocessing_store_cfg
+     */
+    class PreprocessingStore
+    {
+    public:
+        /**
+         * @brief Operation mode of the store.
+         */
+        enum class Mode
+        {
+            /** Artifacts of assessed images are written. */
+            Write,
+            /** Artifacts are loaded instead of running the pre-processing networks. */
+            Read
+        };
+
+        /**
+         * @brief Artifacts loaded by \link Load \endlink.
+         */
+        struct LoadedArtifacts
+        {
+            /** @brief The face geometry has been loaded. */
+            bool faceGeometry = false;
+            /** @brief The segmentations have been loaded. */
+            bool segmentations = false;
+        };
+
+        /**
+         * @brief Constructor
+         * @param mode Operation mode.
+         * @param directory Directory containing the files of the store.
+         * @param configurationHash Hash of the configuration of the pre-processing as computed by
+         * \link ConfigurationHash \endlink.
+         */
+        PreprocessingStore(Mode mode, const std::string& directory, uint64_t configurationHash = 0);
+
+        /**
+         * @brief Creates the store configured in <code>params.preprocessing_store</code>.
+         * @param config Configuration object.
+         * @return The store; null if disabled.
+         */
+        static std::unique_ptr<PreprocessingStore> FromConfiguration(const Configuration& config);
+
+        /**
+         * @brief Computes the hash of the parameters the pre-processing depends on.
+         * @details Includes the parameters of the face detector, the landmark extractor, the face geometry,
+         * the head pose estimator and the segmentation networks, the size and modification time of their
+         * model files and the library version, but none of the parameters of the measures.
+         * @param config Configuration object.
+         * @return Hash value computed by \link OFIQ_LIB::Configuration::GetHash() Configuration::GetHash()\endlink.
+         */
+        static uint64_t ConfigurationHash(const Configuration& config);
+
+        /**
+         * @brief Operation mode of the store.
+         * @return Mode passed to the constructor.
+         */
+        Mode GetMode() const { return m_mode; }
+
+        /**
+         * @brief Writes the artifacts present in a session.
+         * @details The segmentations are only written if present, i.e. if the segmentation stage has run.
+         * A file written before for the same image is replaced.
+         * @param session Session whose face geometry has been computed.
+         * @throws OFIQError if the file cannot be written.
+         */
+        void Save(const Session& session) const;
+
+        /**
+         * @brief Loads the stored artifacts of the image of a session into the session.
+         * @details The landmarked region of the aligned face is not stored since it depends on measure
+         * parameters; it has to be computed from the loaded aligned landmarks.
+         * @param session Session of the image.
+         * @param faceGeometry Load the face geometry.
+         * @param segmentations Load the segmentations; requires the face geometry to be loaded before
+         * or in the same call.
+         * @return Artifacts found and loaded; nothing is loaded if the image is not stored or has been
+         * stored with a different configuration of the pre-processing.
+         */
+        LoadedArtifacts Load(Session& session, bool faceGeometry, bool segmentations) const;
+
+    private:
+        /**
+         * @brief Path of the file storing the artifacts of an image.
+         * @param image Original image of the session.
+         * @return Path within the directory of the store.
+         */
+        std::string FilePath(const OFIQ::Image& image) const;
+
+        /**
+         * @brief Operation mode.
+         */
+        Mode m_mode;
+
+        /**
+         * @brief Directory containing the files of the store.
+         */
+        std::string m_directory;
+
+        /**
+         * @brief Hash of the configuration of the pre-processing written to and expected in the files.
+         */
+        uint64_t m_configurationHash;
+
+        /**
+         * @brief JSON/JAXN key of the operation mode: "off", "write" or "read".
+         */
+        static const std::string m_paramMode;
+
+        /**
+         * @brief JSON/JAXN key of the directory containing the files of the store.
+         */
+        static const std::string m_paramDirectory;
+    };
+}
@@ -0,0 +1,194 @@
+/**
+ * @file ResultCache.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Content-addressed cache of quality assessments.
+ * @author OFIQ development team
+ */
+#pragma once
+
+#include "Configuration.h"
+#include "ofiq_lib.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Namespace for OFIQ implementations.
+ */
+namespace OFIQ_LIB
+{
+    /**
+     * @brief Least recently used cache of quality assessments keyed by the content of the image.
+     * @details The key is a hash of the image dimensions and pixel data combined with the hash of the
+     * configuration, such that resubmitted images are not assessed again. Optionally, assessments are
+     * also stored in a directory and found there after the in-memory entry has been evicted or by other
+     * processes using the same directory and configuration. Pre-processing results are kept in memory only.
+     * @see @ref sec_result_cache_cfg
+     */
+    class ResultCache
+    {
+    public:
+        /**
+         * @brief Cached results of an image.
+         */
+        struct Entry
+        {
+            /**
+             * @brief Quality assessment of the image.
+             */
+            OFIQ::FaceImageQualityAssessment assessment;
+
+            /**
+             * @brief Pre-processing results of the image requested so far.
+             */
+            OFIQ::FaceImageQualityPreprocessingResult preprocessingResult;
+
+            /**
+             * @brief Mask of \link OFIQ::PreprocessingResultType PreprocessingResultType\endlink values
+             * present in <code>preprocessingResult</code>.
+             */
+            uint32_t preprocessingMask = 0;
+        };
+
+        /**
+         * @brief Constructor
+         * @param capacity Maximum number of entries held in memory; at least 1.
+         * @param directory Directory of the persistent store; empty if assessments are not persisted.
+         * @param configurationHash Hash of the configuration, see
+         * \link OFIQ_LIB::Configuration::GetHash() Configuration::GetHash()\endlink.
+         */
+        ResultCache(size_t capacity, const std::string& directory, uint64_t configurationHash);
+
+        /**
+         * @brief Creates the cache configured in <code>params.result_cache</code>.
+         * @param config Configuration object.
+         * @return The cache; null if the cache is disabled.
+         */
+        static std::unique_ptr<ResultCache> FromConfiguration(const Configuration& config);
+
+        /**
+         * @brief Computes the key of an image.
+         * @param image Image to be assessed.
+         * @return Hash of the image content and the configuration.
+         */
+        uint64_t Key(const OFIQ::Image& image) const;
+
+        /**
+         * @brief Looks up the results of an image.
+         * @details Entries found in the persistent store only are loaded into memory; they never contain
+         * pre-processing results.
+         * @param key Key of the image returned by \link Key() \endlink.
+         * @param preprocessingMask Pre-processing results the entry has to contain.
+         * @param entry Receives a copy of the cached results; its masks do not share memory with the cache.
+         * @param area Number of pixels of the image, i.e. the size of the masks.
+         * @return true if the results are cached.
+         */
+        bool Find(uint64_t key, uint32_t preprocessingMask, Entry& entry, size_t area);
+
+        /**
+         * @brief Stores the results of an image as the most recently used entry.
+         * @details Evicts the least recently used entry if the capacity is exceeded
+         * and writes the assessment to the persistent store.
+         * @param key Key of the image returned by \link Key() \endlink.
+         * @param entry Results of the image.
+         */
+        void Insert(uint64_t key, Entry entry);
+
+        /**
+         * @brief Copies the requested members of pre-processing results.
+         * @details Masks are copied such that the copies do not share memory with the source.
+         * @param source Pre-processing results to be copied.
+         * @param preprocessingMask Mask of \link OFIQ::PreprocessingResultType PreprocessingResultType\endlink
+         * values to be copied.
+         * @param area Number of pixels of the image, i.e. the size of the masks.
+         * @param target Receives the requested members.
+         */
+        static void CopyPreprocessingResult(
+            const OFIQ::FaceImageQualityPreprocessingResult& source,
+            uint32_t preprocessingMask,
+            size_t area,
+            OFIQ::FaceImageQualityPreprocessingResult& target);
+
+    private:
+        /**
+         * @brief Reads an assessment from the persistent store.
+         * @param key Key of the image.
+         * @param assessment Receives the stored assessment.
+         * @return true if the store contains a valid file for the key.
+         */
+        bool Load(uint64_t key, OFIQ::FaceImageQualityAssessment& assessment) const;
+
+        /**
+         * @brief Writes an assessment to the persistent store.
+         * @details The file is written under a temporary name and renamed, such that concurrent
+         * readers never see partially written files. Failures are ignored.
+         * @param key Key of the image.
+         * @param assessment Assessment to be stored.
+         */
+        void Store(uint64_t key, const OFIQ::FaceImageQualityAssessment& assessment) const;
+
+        /**
+         * @brief Path of the file storing the assessment of a key.
+         * @param key Key of the image.
+         * @return Path within the directory of the persistent store.
+         */
+        std::string FilePath(uint64_t key) const;
+
+        /**
+         * @brief Maximum number of entries held in memory.
+         */
+        size_t m_capacity;
+
+        /**
+         * @brief Directory of the persistent store; empty if disabled.
+         */
+        std::string m_directory;
+
+        /**
+         * @brief Hash of the configuration used as seed of all keys.
+         */
+        uint64_t m_configurationHash;
+
+        /**
+         * @brief Entries ordered from the most to the least recently used one.
+         */
+        std::list<std::pair<uint64_t, Entry>> m_entries;
+
+        /**
+         * @brief Position of each key in <code>m_entries</code>.
+         */
+        std::unordered_map<uint64_t, std::list<std::pair<uint64_t, Entry>>::iterator> m_index;
+
+        /**
+         * @brief JSON/JAXN key of the maximum number of entries held in memory.
+         */
+        static const std::string m_paramCapacity;
+
+        /**
+         * @brief JSON/JAXN key of the directory of the persistent store.
+         */
+        static const std::string m_paramDirectory;
+    };
+}
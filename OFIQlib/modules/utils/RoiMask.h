@@ -0,0 +1,165 @@
+/**
+ * @file RoiMask.h
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @brief Compact representation of a binary mask that is non-zero only inside a rectangular region.
+ * @author OFIQ development team
+ */
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * Namespace for OFIQ implementations.
+ */
+namespace OFIQ_LIB
+{
+    /**
+     * @brief Binary mask restricted to a region of interest of a larger image.
+     * @details Masks such as the landmarked face region only cover a small part of the image they refer to.
+     * Instead of a zero-initialised image of full size, this class stores the bounding box of the
+     * non-zero area together with the mask values inside that box. Pixels outside the box are zero
+     * by definition.
+     */
+    class RoiMask
+    {
+    public:
+        /**
+         * @brief Constructs an empty mask.
+         */
+        RoiMask() = default;
+
+        /**
+         * @brief Constructs a mask from a region of interest and its content.
+         * @param imageSize Size of the image the mask refers to.
+         * @param roi Region of interest in image coordinates; will be clipped to the image.
+         * @param data Mask values inside <code>roi</code> of type CV_8UC1 and of the same size as the
+         * clipped region of interest. If empty, a zero mask of that size is allocated.
+         */
+        RoiMask(const cv::Size& imageSize, const cv::Rect& roi, const cv::Mat& data = cv::Mat());
+
+        /**
+         * @brief Creates a mask from an image of full size.
+         * @details The region of interest is set to the bounding box of the non-zero pixels.
+         * @param mask Matrix of type CV_8UC1.
+         * @return Mask restricted to the bounding box of its non-zero pixels.
+         */
+        static RoiMask FromMat(const cv::Mat& mask);
+
+        /**
+         * @brief Creates a mask by filling a convex polygon with 1.
+         * @details Equivalent to <code>cv::fillConvexPoly</code> on a zero image of size <code>imageSize</code>.
+         * @param imageSize Size of the image the mask refers to.
+         * @param polygon Vertices of the convex polygon in image coordinates.
+         * @return Mask restricted to the bounding box of the polygon.
+         */
+        static RoiMask FromConvexPolygon(const cv::Size& imageSize, std::vector<cv::Point2i> polygon);
+
+        /**
+         * @brief Creates a mask by filling polygons with 1.
+         * @details Equivalent to <code>cv::fillPoly</code> on a zero image of size <code>imageSize</code>.
+         * @param imageSize Size of the image the mask refers to.
+         * @param polygons Polygons in image coordinates.
+         * @return Mask restricted to the bounding box of all polygons.
+         */
+        static RoiMask FromPolygons(const cv::Size& imageSize, const std::vector<std::vector<cv::Point2i>>& polygons);
+
+        /**
+         * @brief Size of the image the mask refers to.
+         * @return Size of the full image.
+         */
+        const cv::Size& imageSize() const { return m_imageSize; }
+
+        /**
+         * @brief Region of interest in image coordinates.
+         * @return Bounding box outside of which the mask is zero.
+         */
+        const cv::Rect& roi() const { return m_roi; }
+
+        /**
+         * @brief Mask values inside the region of interest.
+         * @details Masks are cached and shared between the measures of a session; the values must not be
+         * modified.
+         * @return Matrix of type CV_8UC1 having the size of \link roi() \endlink.
+         */
+        const cv::Mat& data() const { return m_data; }
+
+        /**
+         * @brief Checks whether the region of interest is empty.
+         * @return true if no pixel can be set.
+         */
+        bool empty() const { return m_roi.empty(); }
+
+        /**
+         * @brief Expands the mask to an image of full size.
+         * @return Matrix of type CV_8UC1 and size \link imageSize() \endlink, zero outside the region of interest.
+         */
+        cv::Mat toMat() const;
+
+        /**
+         * @brief Counts the non-zero pixels of the mask.
+         * @return Number of non-zero pixels.
+         */
+        int countNonZero() const;
+
+        /**
+         * @brief Counts the pixels that are non-zero both in this mask and in <code>mask</code>.
+         * @details Only the pixels inside the region of interest are visited.
+         * @param mask Matrix of type CV_8UC1 and size \link imageSize() \endlink.
+         * @return Number of pixels in the intersection.
+         */
+        int countIntersection(const cv::Mat& mask) const;
+
+        /**
+         * @brief Counts the pixels that are non-zero both in this mask and in <code>other</code>.
+         * @details Only the pixels inside the intersection of both regions of interest are visited.
+         * @param other Mask referring to an image of the same size.
+         * @return Number of pixels in the intersection.
+         */
+        int countIntersection(const RoiMask& other) const;
+
+        /**
+         * @brief Counts the pixels that are non-zero in this mask but zero in <code>mask</code>.
+         * @details This equals <code>cv::countNonZero(thisMask.mul(1 - mask))</code> for binary masks
+         * without allocating temporaries of full size.
+         * @param mask Matrix of type CV_8UC1 and size \link imageSize() \endlink.
+         * @return Number of pixels in the difference.
+         */
+        int countDifference(const cv::Mat& mask) const;
+
+    private:
+        /**
+         * @brief Size of the image the mask refers to.
+         */
+        cv::Size m_imageSize;
+
+        /**
+         * @brief Region of interest in image coordinates.
+         */
+        cv::Rect m_roi;
+
+        /**
+         * @brief Mask values inside the region of interest.
+         */
+        cv::Mat m_data;
+    };
+}
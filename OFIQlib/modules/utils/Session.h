@@ -28,6 +28,10 @@
 #pragma once
 
 #include "ofiq_lib.h"
+#include "RoiMask.h"
+#include "ClassCounts.h"
+#include "Interruption.h"
+#include <memory>
 #include <opencv2/opencv.hpp>
 
 /**
@@ -71,12 +75,134 @@ namespace OFIQ_LIB
          */
         const OFIQ::Image& image() const { return m_image; }
 
+        /**
+         * @brief Access to the input image converted to a BGR matrix.
+         * @details The conversion (see \link OFIQ_LIB::copyToCvImage copyToCvImage \endlink) is done on first use
+         * only; all further calls return the same matrix. The matrix is shared by all consumers
+         * and must not be modified.
+         * @return Reference to the input image in BGR format.
+         */
+        const cv::Mat& getImageBGR() const;
+
+        /**
+         * @brief Access to the input image converted to a grey-scale matrix.
+         * @details The conversion is done on first use only; all further calls return the same matrix.
+         * The matrix is shared by all consumers and must not be modified.
+         * @return Reference to the input image in grey-scale format.
+         */
+        const cv::Mat& getImageGray() const;
+
         /**
          * @brief Access reference to the FaceImageQualityAssessment object, connected to this session.
          * @return quality assessment object reference.
          */
         OFIQ::FaceImageQualityAssessment& assessment() { return m_assessment; }
 
+        /**
+         * @brief Access to the fixed-layout results of the measures computed in this session.
+         * @details Measures store their results here without allocating. The results are
+         * transferred to \link assessment() \endlink by \link publishQualityResults() \endlink.
+         * @return Reference to the dense quality assessment container.
+         */
+        OFIQ::DenseQualityAssessments& qualityResults() { return m_qualityResults; }
+
+        /**
+         * @brief Read-only access to the fixed-layout results of the measures computed in this session.
+         * @return Reference to the dense quality assessment container.
+         */
+        const OFIQ::DenseQualityAssessments& qualityResults() const { return m_qualityResults; }
+
+        /**
+         * @brief Inserts the results stored in \link qualityResults() \endlink into the 
+         * <code>qAssessments</code> map of \link assessment() \endlink.
+         */
+        void publishQualityResults() { m_qualityResults.copyTo(m_assessment.qAssessments); }
+
+        /**
+         * @brief Restricts the measures computed in this session.
+         * 
+         * @param i_measures Measures to be computed; by default all activated measures are computed.
+         */
+        void setMeasureSelection(const OFIQ::QualityMeasureSelection& i_measures) { m_measureSelection = i_measures; }
+
+        /**
+         * @brief Access to the measures to be computed in this session.
+         * 
+         * @return const OFIQ::QualityMeasureSelection& Reference to the selection.
+         */
+        const OFIQ::QualityMeasureSelection& measureSelection() const { return m_measureSelection; }
+
+        /**
+         * @brief Sets pre-processing results computed by the caller.
+         * 
+         * @param i_preprocessingInput Results to be used instead of running the corresponding networks.
+         */
+        void setPreprocessingInput(const OFIQ::FaceImageQualityPreprocessingInput& i_preprocessingInput)
+        {
+            m_preprocessingInput = i_preprocessingInput;
+        }
+
+        /**
+         * @brief Access to the pre-processing results computed by the caller.
+         * 
+         * @return const OFIQ::FaceImageQualityPreprocessingInput& Reference to the results; empty by default.
+         */
+        const OFIQ::FaceImageQualityPreprocessingInput& preprocessingInput() const { return m_preprocessingInput; }
+
+        /**
+         * @brief Sets the callbacks receiving intermediate results of this session.
+         * 
+         * @param i_progress Callbacks; must outlive the session.
+         */
+        void setProgress(const OFIQ::AssessmentProgress& i_progress) { m_progress = &i_progress; }
+
+        /**
+         * @brief Reports an available pre-processing result to the progress callbacks.
+         * 
+         * @param i_type Type of the pre-processing result.
+         * @param i_result Artifact of the pre-processing result passed to the callback.
+         * @return false if the session has been cancelled.
+         */
+        bool reportPreprocessingResult(
+            OFIQ::PreprocessingResultType i_type, const OFIQ::FaceImageQualityPreprocessingResult& i_result);
+
+        /**
+         * @brief Checks whether a callback receives pre-processing results.
+         * @details Used to skip the conversion of artifacts nobody receives.
+         * @return true if \link reportPreprocessingResult \endlink invokes a callback.
+         */
+        bool hasPreprocessingProgress() const { return m_progress != nullptr && m_progress->onPreprocessingResult != nullptr; }
+
+        /**
+         * @brief Reports the result of a measure stored in \link qualityResults() \endlink to the progress callbacks.
+         * 
+         * @param i_measure Measure whose result has been computed.
+         * @return false if the session has been cancelled.
+         */
+        bool reportMeasureResult(OFIQ::QualityMeasure i_measure);
+
+        /**
+         * @brief Sets the interruption aborting this session on cancellation or when its deadline has passed.
+         * 
+         * @param i_interruption Interruption; must outlive the session.
+         */
+        void setInterruption(const Interruption& i_interruption) { m_interruption = &i_interruption; }
+
+        /**
+         * @brief Checks whether a progress callback or the interruption has cancelled this session.
+         * 
+         * @return true if the remaining computations are to be skipped.
+         */
+        bool isCancelled() const;
+
+        /**
+         * @brief Return code of a cancelled session.
+         * 
+         * @return \link OFIQ::ReturnCode::DeadlineExceeded ReturnCode::DeadlineExceeded\endlink if the
+         * deadline of the interruption has passed, otherwise \link OFIQ::ReturnCode::Cancelled ReturnCode::Cancelled\endlink.
+         */
+        OFIQ::ReturnCode cancellationCode() const;
+
         /**
          * @brief Access to the id connected to this session.
          * 
@@ -187,6 +313,21 @@ namespace OFIQ_LIB
          */
         cv::Mat getAlignedFaceLandmarkedRegion() const;
 
+        /**
+         * @brief Set the Aligned Face Landmarked Region from a mask restricted to its region of interest.
+         * @details The full-size image returned by \link getAlignedFaceLandmarkedRegion \endlink is expanded from the mask.
+         * 
+         * @param i_alignedFaceRegion 
+         */
+        void setAlignedFaceLandmarkedRegion(const RoiMask& i_alignedFaceRegion);
+
+        /**
+         * @brief Get the Aligned Face Landmarked Region restricted to its region of interest.
+         * 
+         * @return const RoiMask& Reference to the mask; no data is copied.
+         */
+        const RoiMask& getAlignedFaceLandmarkedRegionRoi() const;
+
         /**
          * @brief Set the Face Parsing Image, see \link OFIQ_LIB::modules::segmentations::FaceParsing \endlink).
          * 
@@ -201,6 +342,31 @@ namespace OFIQ_LIB
          */
         cv::Mat getFaceParsingImage() const;
 
+        /**
+         * @brief Read-only access to the Face Parsing Image without copying it.
+         * 
+         * @return const cv::Mat& Reference to the stored face parsing image.
+         */
+        const cv::Mat& faceParsingImage() const { return m_faceParsingImage; }
+
+        /**
+         * @brief Set the per-class pixel counts of the Face Parsing Image.
+         * @details The counts are computed together with the face parsing, see
+         * \link OFIQ_LIB::SegmentationExtractorInterface::GetClassCounts SegmentationExtractorInterface::GetClassCounts \endlink.
+         * They must refer to the image passed to \link setFaceParsingImage \endlink before.
+         * 
+         * @param i_classCounts Counts of the face parsing image; may be null.
+         */
+        void setFaceParsingClassCounts(std::shared_ptr<const ClassCounts> i_classCounts);
+
+        /**
+         * @brief Get the per-class pixel counts of the Face Parsing Image.
+         * @details If no counts have been set, they are computed from the face parsing image on first use.
+         * 
+         * @return const ClassCounts& Reference to the counts.
+         */
+        const ClassCounts& getFaceParsingClassCounts() const;
+
         /**
          * @brief Set the Face Occlusion Segmentation Image, see \link OFIQ_LIB::modules::segmentations::FaceOcclusionSegmentation \endlink)
          * 
@@ -215,6 +381,39 @@ namespace OFIQ_LIB
          */
         cv::Mat getFaceOcclusionSegmentationImage() const;
 
+        /**
+         * @brief Read-only access to the Face Occlusion Segmentation Image without copying it.
+         * 
+         * @return const cv::Mat& Reference to the stored segmentation image.
+         */
+        const cv::Mat& faceOcclusionSegmentationImage() const { return m_faceOcclusionSegmentationImage; }
+
+        /**
+         * @brief Looks up a face mask that has been computed before for this session.
+         * @details Face masks are computed from the convex hull of the facial landmarks, see
+         * \link OFIQ_LIB::modules::landmarks::FaceMeasures::GetFaceMaskRoi FaceMeasures::GetFaceMaskRoi \endlink.
+         * Several measures ask for the same mask; caching it avoids repeated rasterizations.
+         * 
+         * @param i_landmarks Landmarks the mask has been computed from.
+         * @param i_size Size of the image the mask refers to.
+         * @param i_alpha Forehead extension parameter the mask has been computed with.
+         * @param o_mask Cached mask, only set if found. It shares its data with the cache and must not be modified.
+         * @return true if a matching mask has been stored before.
+         */
+        bool findFaceMask(
+            const OFIQ::FaceLandmarks& i_landmarks, const cv::Size& i_size, float i_alpha, RoiMask& o_mask) const;
+
+        /**
+         * @brief Stores a face mask for later use by \link findFaceMask \endlink.
+         * 
+         * @param i_landmarks Landmarks the mask has been computed from.
+         * @param i_size Size of the image the mask refers to.
+         * @param i_alpha Forehead extension parameter the mask has been computed with.
+         * @param i_mask Mask to be stored.
+         */
+        void storeFaceMask(
+            const OFIQ::FaceLandmarks& i_landmarks, const cv::Size& i_size, float i_alpha, const RoiMask& i_mask);
+
     private:
         /**
          * @brief Reference to the input image, connected to this session.
@@ -227,6 +426,55 @@ namespace OFIQ_LIB
          * 
          */
         OFIQ::FaceImageQualityAssessment& m_assessment;
+
+        /**
+         * @brief Results of the measures computed in this session, indexed by measure.
+         * 
+         */
+        OFIQ::DenseQualityAssessments m_qualityResults;
+
+        /**
+         * @brief Measures to be computed in this session.
+         * 
+         */
+        OFIQ::QualityMeasureSelection m_measureSelection{ OFIQ::QualityMeasureSelection::All() };
+
+        /**
+         * @brief Pre-processing results computed by the caller.
+         * 
+         */
+        OFIQ::FaceImageQualityPreprocessingInput m_preprocessingInput;
+
+        /**
+         * @brief Callbacks receiving intermediate results; null if not requested.
+         * 
+         */
+        const OFIQ::AssessmentProgress* m_progress = nullptr;
+
+        /**
+         * @brief Set when a progress callback has cancelled this session.
+         * 
+         */
+        bool m_cancelled = false;
+
+        /**
+         * @brief Interruption aborting the session; null if not requested.
+         * 
+         */
+        const Interruption* m_interruption = nullptr;
+
+        /**
+         * @brief Input image in BGR format, created on first use by \link getImageBGR \endlink.
+         * 
+         */
+        mutable cv::Mat m_imageBGR;
+
+        /**
+         * @brief Input image in grey-scale format, created on first use by \link getImageGray \endlink.
+         * 
+         */
+        mutable cv::Mat m_imageGray;
+
         /**
          * @brief Container for the faces found on the input image.
          * 
@@ -269,20 +517,65 @@ namespace OFIQ_LIB
          */
         cv::Mat m_alignedFacelandmarkedRegion;
 
+        /**
+         * @brief Container for storing the landmarked region of the aligned face image restricted to its region of interest.
+         * 
+         */
+        RoiMask m_alignedFacelandmarkedRegionRoi;
+
         /**
          * @brief Container for storing the segmented face image
          * 
          */
         cv::Mat m_faceParsingImage;
 
+        /**
+         * @brief Per-class pixel counts of the face parsing image, see \link getFaceParsingClassCounts \endlink.
+         */
+        mutable std::shared_ptr<const ClassCounts> m_faceParsingClassCounts;
+
         /**
          * @brief Container for storing the result of the face occlusion segmented image.
          * 
          */
         cv::Mat m_faceOcclusionSegmentationImage;
 
+        /**
+         * @brief Entry of the face mask cache.
+         * 
+         */
+        struct FaceMaskCacheEntry
+        {
+            /**
+             * @brief Landmarks the mask has been computed from.
+             */
+            OFIQ::FaceLandmarks landmarks;
+
+            /**
+             * @brief Size of the image the mask refers to.
+             */
+            cv::Size size;
+
+            /**
+             * @brief Forehead extension parameter.
+             */
+            float alpha;
+
+            /**
+             * @brief The cached mask.
+             */
+            RoiMask mask;
+        };
+
+        /**
+         * @brief Container for the face masks computed during this session.
+         * @details Only a few distinct masks are requested per session, hence a linear search is sufficient.
+         */
+        std::vector<FaceMaskCacheEntry> m_faceMasks;
+
         /**
          * @brief Method for generating uuid's for the session.
+         * @details Thread-safe; the ids are unique within the process.
          * 
          * @return std::string 
          */
@@ -0,0 +1,74 @@
+/**
+ * @file ClassCounts.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "ClassCounts.h"
+#include "OFIQError.h"
+#include <algorithm>
+#include <array>
+
+namespace OFIQ_LIB
+{
+    ClassCounts::ClassCounts(int rows)
+        : m_rows{std::max(rows, 0)},
+          m_prefixCounts(static_cast<size_t>(m_rows + 1) * numberOfLabels, 0)
+    {
+    }
+
+    ClassCounts ClassCounts::FromImage(const cv::Mat& labels)
+    {
+        if (labels.empty())
+            return {};
+        if (labels.type() != CV_8UC1)
+            throw OFIQError(OFIQ::ReturnCode::UnknownError, "class counts require a label image of type CV_8UC1");
+
+        ClassCounts counts(labels.rows);
+        for (int y = 0; y < labels.rows; y++)
+            counts.addRow(y, labels.ptr<uchar>(y), labels.cols);
+        return counts;
+    }
+
+    void ClassCounts::addRow(int y, const uchar* labels, int width)
+    {
+        std::array<int, 256> histogram{};
+        for (int x = 0; x < width; x++)
+            histogram[labels[x]]++;
+
+        const int* previous = m_prefixCounts.data() + static_cast<size_t>(y) * numberOfLabels;
+        int* current = m_prefixCounts.data() + static_cast<size_t>(y + 1) * numberOfLabels;
+        for (int label = 0; label < numberOfLabels; label++)
+            current[label] = previous[label] + histogram[label];
+    }
+
+    int ClassCounts::count(int label, int rowBegin, int rowEnd) const
+    {
+        if (label < 0 || label >= numberOfLabels)
+            return 0;
+        rowBegin = std::clamp(rowBegin, 0, m_rows);
+        rowEnd = std::clamp(rowEnd, rowBegin, m_rows);
+        return m_prefixCounts[static_cast<size_t>(rowEnd) * numberOfLabels + label] -
+               m_prefixCounts[static_cast<size_t>(rowBegin) * numberOfLabels + label];
+    }
+}
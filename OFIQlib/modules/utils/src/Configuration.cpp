@@ -27,6 +27,8 @@
 #include "Configuration.h"
 
 #include "OFIQError.h"
+#include "utils.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <magic_enum.hpp>
@@ -91,6 +93,54 @@ namespace OFIQ_LIB
         m_dataDir = dataDir;
     }
 
+    /**
+     * @brief Mixes size and modification time of a model file into a hash.
+     * @details Missing files are mixed in as a marker only, so that a later
+     * installation of the file changes the hash.
+     * @param path Path of the model file.
+     * @param seed Hash to be extended.
+     * @return Extended hash.
+     */
+    static uint64_t HashModelFile(const fs::path& path, uint64_t seed)
+    {
+        std::error_code error;
+        const auto size = static_cast<uint64_t>(fs::file_size(path, error));
+        if (error)
+        {
+            const char missing = 0;
+            return hashBytes(&missing, sizeof(missing), seed);
+        }
+        const auto modified = static_cast<int64_t>(fs::last_write_time(path, error).time_since_epoch().count());
+        const uint64_t stamp[2] = {size, error ? 0 : static_cast<uint64_t>(modified)};
+        return hashBytes(stamp, sizeof(stamp), seed);
+    }
+
+    uint64_t Configuration::GetHash() const
+    {
+        return GetHash(std::vector<std::string>{""});
+    }
+
+    uint64_t Configuration::GetHash(const std::vector<std::string>& keyPrefixes) const
+    {
+        const int version[3] = {int(OFIQ_VERSION_MAJOR), int(OFIQ_VERSION_MINOR), int(OFIQ_VERSION_PATCH)};
+        uint64_t hash = hashBytes(version, sizeof(version));
+        const std::string dataDir = m_dataDir.string();
+        hash = hashBytes(dataDir.data(), dataDir.size(), hash);
+        for (const auto& [key, value] : parameters)
+        {
+            if (std::none_of(keyPrefixes.begin(), keyPrefixes.end(),
+                    [&key](const std::string& prefix) { return key.starts_with(prefix); }))
+                continue;
+            hash = hashBytes(key.data(), key.size(), hash);
+            const std::string serialized = tao::json::to_string(value);
+            hash = hashBytes(serialized.data(), serialized.size(), hash);
+            // model files are referenced by keys ending in "_path", relative to the data directory
+            if (key.ends_with("_path") && value.is_string())
+                hash = HashModelFile(m_dataDir / value.get_string(), hash);
+        }
+        return hash;
+    }
+
     bool Configuration::GetBool(const std::string& key, bool& value) const
     {
         std::map<std::string, tao::json::value, std::less<>>::const_iterator citModel = parameters.find(key);
@@ -0,0 +1,119 @@
+/**
+ * @file GeometryPlan.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "GeometryPlan.h"
+#include "OFIQError.h"
+#include <magic_enum.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace OFIQ_LIB
+{
+    static const std::string directWarpConfigItem = "params.geometry.direct_warp";
+    static const std::string alignmentConfigItem = "params.geometry.alignment";
+
+    bool GeometryPlan::IsDirectWarpEnabled(const Configuration& configuration)
+    {
+        bool directWarp = false;
+        if (!configuration.GetBool(directWarpConfigItem, directWarp))
+            directWarp = false;
+        return directWarp;
+    }
+
+    AlignmentMethod GeometryPlan::GetAlignmentMethod(const Configuration& configuration)
+    {
+        std::string methodName;
+        if (!configuration.GetString(alignmentConfigItem, methodName))
+            return AlignmentMethod::LMEDS;
+
+        auto method = magic_enum::enum_cast<AlignmentMethod>(methodName);
+        if (!method.has_value())
+            throw OFIQError(
+                OFIQ::ReturnCode::NotImplemented,
+                "Unknown alignment method '" + methodName + "' in " + alignmentConfigItem);
+        return method.value();
+    }
+
+    GeometryPlan GeometryPlan::FromAlignedFace(const Session& session)
+    {
+        cv::Mat alignment = session.getAlignedFaceTransformationMatrix();
+        cv::Matx23d transform;
+        cv::Mat transformView(transform, false);
+        alignment.convertTo(transformView, CV_64F);
+        return GeometryPlan(transform, cv::Size(alignedFaceSize, alignedFaceSize));
+    }
+
+    GeometryPlan::GeometryPlan(const cv::Matx23d& transform, const cv::Size& size)
+        : m_transform{transform},
+          m_size{size}
+    {
+    }
+
+    GeometryPlan& GeometryPlan::crop(const cv::Rect& roi)
+    {
+        compose(cv::Matx23d(
+            1, 0, -roi.x,
+            0, 1, -roi.y));
+        m_size = roi.size();
+        return *this;
+    }
+
+    GeometryPlan& GeometryPlan::resize(const cv::Size& size)
+    {
+        // cv::resize maps the target pixel x to the source position (x + 0.5) * s - 0.5
+        const double scaleX = static_cast<double>(size.width) / m_size.width;
+        const double scaleY = static_cast<double>(size.height) / m_size.height;
+        compose(cv::Matx23d(
+            scaleX, 0, 0.5 * scaleX - 0.5,
+            0, scaleY, 0.5 * scaleY - 0.5));
+        m_size = size;
+        return *this;
+    }
+
+    cv::Mat GeometryPlan::warp(const cv::Mat& source) const
+    {
+        cv::Mat target;
+        cv::warpAffine(
+            source, target, cv::Mat(m_transform), m_size,
+            cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar::all(0));
+        return target;
+    }
+
+    void GeometryPlan::compose(const cv::Matx23d& next)
+    {
+        const cv::Matx33d current(
+            m_transform(0, 0), m_transform(0, 1), m_transform(0, 2),
+            m_transform(1, 0), m_transform(1, 1), m_transform(1, 2),
+            0, 0, 1);
+        const cv::Matx33d appended(
+            next(0, 0), next(0, 1), next(0, 2),
+            next(1, 0), next(1, 1), next(1, 2),
+            0, 0, 1);
+        const cv::Matx33d product = appended * current;
+        m_transform = cv::Matx23d(
+            product(0, 0), product(0, 1), product(0, 2),
+            product(1, 0), product(1, 1), product(1, 2));
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Interruption.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+
+#include "Interruption.h"
+#include <algorithm>
+#include <onnxruntime_cxx_api.h>
+
+namespace OFIQ_LIB
+{
+    /**
+     * @brief Most recently created interruption of the thread.
+     */
+    static thread_local Interruption* currentInterruption = nullptr;
+
+    Interruption::ScopedRun::ScopedRun(Ort::RunOptions& runOptions)
+        : m_interruption{Current()}
+    {
+        if (m_interruption != nullptr)
+            m_interruption->Register(runOptions);
+    }
+
+    Interruption::ScopedRun::~ScopedRun()
+    {
+        if (m_interruption != nullptr)
+            m_interruption->Unregister();
+    }
+
+    Interruption::Interruption(const OFIQ::AssessmentCancellation& cancellation)
+        : m_token{cancellation.token}, m_deadline{cancellation.deadline}, m_previous{currentInterruption}
+    {
+        currentInterruption = this;
+        if (m_token != nullptr || m_deadline != std::chrono::steady_clock::time_point::max())
+            m_watchdog = std::thread(&Interruption::Watch, this);
+    }
+
+    Interruption::~Interruption()
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stopping = true;
+        }
+        m_stop.notify_all();
+        if (m_watchdog.joinable())
+            m_watchdog.join();
+        currentInterruption = m_previous;
+    }
+
+    bool Interruption::isInterrupted() const
+    {
+        return (m_token != nullptr && m_token->isCancelled()) ||
+            std::chrono::steady_clock::now() >= m_deadline;
+    }
+
+    OFIQ::ReturnCode Interruption::reason() const
+    {
+        return m_token != nullptr && m_token->isCancelled() ?
+            OFIQ::ReturnCode::Cancelled : OFIQ::ReturnCode::DeadlineExceeded;
+    }
+
+    Interruption* Interruption::Current()
+    {
+        return currentInterruption;
+    }
+
+    void Interruption::Watch()
+    {
+        std::unique_lock lock(m_mutex);
+        while (!m_stopping)
+        {
+            if (isInterrupted())
+            {
+                // inferences started later are terminated on registration
+                if (m_activeRun != nullptr)
+                    m_activeRun->SetTerminate();
+                return;
+            }
+
+            // the token cannot notify the watchdog and is polled
+            const auto wakeUp = m_token != nullptr ?
+                std::min(std::chrono::steady_clock::now() + pollInterval, m_deadline) : m_deadline;
+            m_stop.wait_until(lock, wakeUp, [this]() { return m_stopping; });
+        }
+    }
+
+    void Interruption::Register(Ort::RunOptions& runOptions)
+    {
+        std::scoped_lock lock(m_mutex);
+        m_activeRun = &runOptions;
+        if (isInterrupted())
+            runOptions.SetTerminate();
+    }
+
+    void Interruption::Unregister()
+    {
+        std::scoped_lock lock(m_mutex);
+        m_activeRun = nullptr;
+    }
+}
@@ -0,0 +1,419 @@
+/**
+ * @file PreprocessingStore.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+
+#include "PreprocessingStore.h"
+#include "OFIQError.h"
+#include "utils.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace fs = std::filesystem;
+
+namespace OFIQ_LIB
+{
+    const std::string PreprocessingStore::m_paramMode = "params.preprocessing_store.mode";
+    const std::string PreprocessingStore::m_paramDirectory = "params.preprocessing_store.directory";
+
+    /**
+     * @brief First bytes of the files of the store, including the format version.
+     */
+    static const std::string fileMagic = "OFIQPP03";
+
+    /**
+     * @brief Prefixes of the configuration keys the stored artifacts depend on.
+     */
+    static const std::vector<std::string> preprocessingKeyPrefixes = {
+        "detector",
+        "landmarks",
+        "params.detector.",
+        "params.landmarks.",
+        "params.geometry.",
+        "params.measures.HeadPose.",
+        "params.measures.FaceParsing.",
+        "params.measures.FaceOcclusionSegmentation."};
+
+    /**
+     * @brief Flag of a file containing the face geometry.
+     */
+    static constexpr uint32_t faceGeometryFlag = 1;
+
+    /**
+     * @brief Flag of a file containing the segmentations.
+     */
+    static constexpr uint32_t segmentationsFlag = 2;
+
+    /**
+     * @brief Appends values in host byte order to a byte buffer.
+     */
+    class ArtifactWriter
+    {
+    public:
+        /**
+         * @brief Appends a value of trivial type.
+         * @param value Value to be appended.
+         */
+        template <typename T>
+        void put(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* bytes = reinterpret_cast<const char*>(&value);
+            m_buffer.append(bytes, sizeof(T));
+        }
+
+        /**
+         * @brief Appends landmarks.
+         * @param landmarks Landmarks to be appended.
+         */
+        void put(const OFIQ::FaceLandmarks& landmarks)
+        {
+            put(static_cast<uint8_t>(landmarks.type));
+            put(static_cast<uint32_t>(landmarks.landmarks.size()));
+            for (const auto& point : landmarks.landmarks)
+            {
+                put(point.x);
+                put(point.y);
+            }
+        }
+
+        /**
+         * @brief Appends a single-channel mask compressed as PNG.
+         * @param mask Matrix of type CV_8UC1.
+         */
+        void put(const cv::Mat& mask)
+        {
+            std::vector<uchar> png;
+            cv::imencode(".png", mask, png);
+            put(static_cast<uint32_t>(png.size()));
+            m_buffer.append(reinterpret_cast<const char*>(png.data()), png.size());
+        }
+
+        /**
+         * @brief Access to the written bytes.
+         * @return Reference to the buffer.
+         */
+        const std::string& buffer() const { return m_buffer; }
+
+    private:
+        /**
+         * @brief Written bytes.
+         */
+        std::string m_buffer;
+    };
+
+    /**
+     * @brief Reads values written by \link ArtifactWriter \endlink.
+     * @details Reading beyond the end of the buffer throws std::out_of_range.
+     */
+    class ArtifactReader
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param buffer Bytes to be read; must outlive the reader.
+         */
+        explicit ArtifactReader(const std::string& buffer) : m_buffer{buffer} {}
+
+        /**
+         * @brief Reads a value of trivial type.
+         * @return The value.
+         */
+        template <typename T>
+        T get()
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        /**
+         * @brief Reads landmarks.
+         * @return The landmarks.
+         */
+        OFIQ::FaceLandmarks getLandmarks()
+        {
+            OFIQ::FaceLandmarks landmarks;
+            landmarks.type = static_cast<OFIQ::LandmarkType>(get<uint8_t>());
+            const auto count = getCount();
+            for (uint32_t i = 0; i < count; i++)
+            {
+                OFIQ::LandmarkPoint point;
+                point.x = get<decltype(point.x)>();
+                point.y = get<decltype(point.y)>();
+                landmarks.landmarks.push_back(point);
+            }
+            return landmarks;
+        }
+
+        /**
+         * @brief Reads a PNG-compressed mask.
+         * @return Matrix of type CV_8UC1.
+         */
+        cv::Mat getMask()
+        {
+            const auto size = get<uint32_t>();
+            const auto* data = reinterpret_cast<const uchar*>(take(size));
+            cv::Mat mask = cv::imdecode(std::vector<uchar>(data, data + size), cv::IMREAD_UNCHANGED);
+            if (mask.empty())
+                throw std::out_of_range("Invalid mask in pre-processing artifacts");
+            return mask;
+        }
+
+        /**
+         * @brief Reads the number of elements of a sequence.
+         * @details Corrupt counts are rejected before memory is allocated for the elements.
+         * @return Number of elements; at most the number of remaining bytes.
+         */
+        uint32_t getCount()
+        {
+            const auto count = get<uint32_t>();
+            if (count > m_buffer.size() - m_position)
+                throw std::out_of_range("Invalid count in pre-processing artifacts");
+            return count;
+        }
+
+    private:
+        /**
+         * @brief Advances the read position.
+         * @param size Number of bytes to be read.
+         * @return Pointer to the bytes.
+         */
+        const char* take(size_t size)
+        {
+            if (size > m_buffer.size() - m_position)
+                throw std::out_of_range("Truncated pre-processing artifacts");
+            const char* data = m_buffer.data() + m_position;
+            m_position += size;
+            return data;
+        }
+
+        /**
+         * @brief Bytes to be read.
+         */
+        const std::string& m_buffer;
+
+        /**
+         * @brief Read position.
+         */
+        size_t m_position = 0;
+    };
+
+    PreprocessingStore::PreprocessingStore(Mode mode, const std::string& directory, uint64_t configurationHash)
+        : m_mode{mode}, m_directory{directory}, m_configurationHash{configurationHash}
+    {
+        if (m_mode == Mode::Write)
+        {
+            std::error_code error;
+            fs::create_directories(m_directory, error);
+        }
+    }
+
+    std::unique_ptr<PreprocessingStore> PreprocessingStore::FromConfiguration(const Configuration& config)
+    {
+        std::string mode;
+        if (!config.GetString(m_paramMode, mode) || mode == "off")
+            return nullptr;
+        if (mode != "write" && mode != "read")
+        {
+            throw OFIQError(
+                OFIQ::ReturnCode::NotImplemented,
+                "Invalid pre-processing store mode '" + mode + "'; expected \"off\", \"write\" or \"read\"");
+        }
+
+        std::string directory = config.GetString(m_paramDirectory);
+        if (fs::path(directory).is_relative())
+            directory = (fs::path(config.getDataDir()) / directory).string();
+
+        return std::make_unique<PreprocessingStore>(
+            mode == "write" ? Mode::Write : Mode::Read, directory, ConfigurationHash(config));
+    }
+
+    uint64_t PreprocessingStore::ConfigurationHash(const Configuration& config)
+    {
+        return config.GetHash(preprocessingKeyPrefixes);
+    }
+
+    std::string PreprocessingStore::FilePath(const OFIQ::Image& image) const
+    {
+        const uint16_t header[3] = {image.width, image.height, image.depth};
+        const uint64_t key = hashBytes(image.data.get(), image.size(), hashBytes(header, sizeof(header)));
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".ofiqpp";
+        return (fs::path(m_directory) / name.str()).string();
+    }
+
+    void PreprocessingStore::Save(const Session& session) const
+    {
+        const cv::Mat transformationMatrix = session.getAlignedFaceTransformationMatrix();
+        const cv::Mat alignedFace = session.getAlignedFace();
+        const bool hasSegmentations =
+            !session.faceParsingImage().empty() && !session.faceOcclusionSegmentationImage().empty();
+
+        ArtifactWriter writer;
+        for (char c : fileMagic)
+            writer.put(c);
+        writer.put(m_configurationHash);
+        writer.put(faceGeometryFlag | (hasSegmentations ? segmentationsFlag : 0));
+
+        const auto faces = session.getDetectedFaces();
+        writer.put(static_cast<uint32_t>(faces.size()));
+        for (const auto& face : faces)
+        {
+            writer.put(face.xleft);
+            writer.put(face.ytop);
+            writer.put(face.width);
+            writer.put(face.height);
+            writer.put(static_cast<uint8_t>(face.faceDetector));
+        }
+        writer.put(session.getLandmarks());
+        for (double angle : session.getPose())
+            writer.put(angle);
+
+        // the transformation is stored since its LMEDS estimation is randomized
+        for (int row = 0; row < 2; row++)
+            for (int col = 0; col < 3; col++)
+                writer.put(transformationMatrix.at<double>(row, col));
+        writer.put(static_cast<int32_t>(alignedFace.cols));
+        writer.put(static_cast<int32_t>(alignedFace.rows));
+        writer.put(session.getAlignedFaceLandmarks());
+
+        if (hasSegmentations)
+        {
+            writer.put(session.faceParsingImage());
+            writer.put(session.faceOcclusionSegmentationImage());
+        }
+
+        const std::string path = FilePath(session.image());
+        // unique per writer since several processes may share the directory
+        const std::string temporaryPath = path + "." + std::to_string(std::random_device{}()) + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(writer.buffer().data(), static_cast<std::streamsize>(writer.buffer().size()));
+            if (!file)
+            {
+                throw OFIQError(
+                    OFIQ::ReturnCode::UnknownError,
+                    "Writing pre-processing artifacts failed: " + temporaryPath);
+            }
+        }
+        std::error_code error;
+        fs::rename(temporaryPath, path, error);
+        if (error)
+        {
+            fs::remove(temporaryPath, error);
+            throw OFIQError(
+                OFIQ::ReturnCode::UnknownError,
+                "Writing pre-processing artifacts failed: " + path);
+        }
+    }
+
+    PreprocessingStore::LoadedArtifacts PreprocessingStore::Load(
+        Session& session, bool faceGeometry, bool segmentations) const
+    {
+        LoadedArtifacts loaded;
+        std::ifstream file(FilePath(session.image()), std::ios::binary);
+        if (!file)
+            return loaded;
+        const std::string buffer{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        try
+        {
+            ArtifactReader reader(buffer);
+            for (char c : fileMagic)
+            {
+                if (reader.get<char>() != c)
+                    return loaded;
+            }
+            // artifacts of another detector, landmarker, alignment or segmentation are treated as missing
+            if (reader.get<uint64_t>() != m_configurationHash)
+                return loaded;
+            const auto flags = reader.get<uint32_t>();
+
+            // the face geometry is read in any case since the segmentations follow it
+            std::vector<OFIQ::BoundingBox> faces(reader.getCount());
+            for (auto& face : faces)
+            {
+                face.xleft = reader.get<int16_t>();
+                face.ytop = reader.get<int16_t>();
+                face.width = reader.get<int16_t>();
+                face.height = reader.get<int16_t>();
+                face.faceDetector = static_cast<OFIQ::FaceDetectorType>(reader.get<uint8_t>());
+            }
+            const OFIQ::FaceLandmarks landmarks = reader.getLandmarks();
+            EulerAngle pose;
+            for (auto& angle : pose)
+                angle = reader.get<double>();
+            cv::Mat transformationMatrix(2, 3, CV_64F);
+            for (int row = 0; row < 2; row++)
+                for (int col = 0; col < 3; col++)
+                    transformationMatrix.at<double>(row, col) = reader.get<double>();
+            const auto alignedWidth = reader.get<int32_t>();
+            const auto alignedHeight = reader.get<int32_t>();
+            const OFIQ::FaceLandmarks alignedLandmarks = reader.getLandmarks();
+
+            if (faceGeometry && (flags & faceGeometryFlag) != 0 && !faces.empty())
+            {
+                session.setDetectedFaces(faces);
+                session.assessment().boundingBox = faces[0];
+                session.setPose(pose);
+                session.setLandmarks(landmarks);
+                cv::Mat alignedFace;
+                cv::warpAffine(
+                    session.getImageBGR(), alignedFace, transformationMatrix, cv::Size(alignedWidth, alignedHeight));
+                session.setAlignedFace(alignedFace);
+                session.setAlignedFaceLandmarks(alignedLandmarks);
+                session.setAlignedFaceTransformationMatrix(transformationMatrix);
+                loaded.faceGeometry = true;
+            }
+
+            if (segmentations && (flags & segmentationsFlag) != 0 &&
+                (loaded.faceGeometry || !faceGeometry))
+            {
+                const cv::Mat faceParsing = reader.getMask();
+                const cv::Mat faceOcclusion = reader.getMask();
+                session.setFaceParsingImage(faceParsing);
+                session.setFaceOcclusionSegmentationImage(faceOcclusion);
+                loaded.segmentations = true;
+            }
+        }
+        catch (const std::out_of_range&)
+        {
+            // a truncated or corrupt file is treated as missing; artifacts set before remain valid
+        }
+        return loaded;
+    }
+}
@@ -0,0 +1,289 @@
+/**
+ * @file ResultCache.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+
+#include "ResultCache.h"
+#include "utils.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace OFIQ_LIB
+{
+    const std::string ResultCache::m_paramCapacity = "params.result_cache.capacity";
+    const std::string ResultCache::m_paramDirectory = "params.result_cache.directory";
+
+    /**
+     * @brief First line of the files of the persistent store.
+     */
+    static const std::string fileHeader = "OFIQ-result-cache 1";
+
+    /**
+     * @brief Copies a mask such that the copy does not share memory with the cache.
+     * @param mask Mask to be copied; may be null.
+     * @param area Number of bytes of the mask.
+     * @return Copy of the mask; null if <code>mask</code> is null.
+     */
+    static std::shared_ptr<uint8_t[]> CopyMask(const std::shared_ptr<uint8_t[]>& mask, size_t area)
+    {
+        if (mask == nullptr)
+            return nullptr;
+        std::shared_ptr<uint8_t[]> copy(new uint8_t[area]);
+        memcpy(copy.get(), mask.get(), area);
+        return copy;
+    }
+
+    /**
+     * @brief Writes a score such that \link ReadScore() ReadScore()\endlink restores it exactly.
+     * @details Non-finite values are written as the tokens <code>nan</code>, <code>inf</code>
+     * and <code>-inf</code>, which stream extraction cannot parse.
+     * @param stream Stream to write to; must use a precision of 17 digits.
+     * @param value Score to be written.
+     */
+    static void WriteScore(std::ostream& stream, double value)
+    {
+        if (std::isnan(value))
+            stream << "nan";
+        else if (std::isinf(value))
+            stream << (value < 0 ? "-inf" : "inf");
+        else
+            stream << value;
+    }
+
+    /**
+     * @brief Reads a score written by \link WriteScore() WriteScore()\endlink.
+     * @param stream Stream to read from.
+     * @param value Receives the score.
+     * @return true if a valid score was read.
+     */
+    static bool ReadScore(std::istream& stream, double& value)
+    {
+        std::string token;
+        if (!(stream >> token))
+            return false;
+        if (token == "nan")
+            value = std::numeric_limits<double>::quiet_NaN();
+        else if (token == "inf")
+            value = std::numeric_limits<double>::infinity();
+        else if (token == "-inf")
+            value = -std::numeric_limits<double>::infinity();
+        else
+        {
+            const char* end = token.data() + token.size();
+            auto [ptr, error] = std::from_chars(token.data(), end, value);
+            if (error != std::errc() || ptr != end)
+                return false;
+        }
+        return true;
+    }
+
+    void ResultCache::CopyPreprocessingResult(
+        const OFIQ::FaceImageQualityPreprocessingResult& source,
+        uint32_t preprocessingMask,
+        size_t area,
+        OFIQ::FaceImageQualityPreprocessingResult& target)
+    {
+        const auto requested = [preprocessingMask](OFIQ::PreprocessingResultType type)
+        {
+            return (preprocessingMask & static_cast<uint32_t>(type)) != 0;
+        };
+        if (requested(OFIQ::PreprocessingResultType::Faces))
+            target.m_faces = source.m_faces;
+        if (requested(OFIQ::PreprocessingResultType::Landmarks))
+            target.m_landmarks = source.m_landmarks;
+        if (requested(OFIQ::PreprocessingResultType::Segmentation))
+            target.m_segmentationMaskPtr = CopyMask(source.m_segmentationMaskPtr, area);
+        if (requested(OFIQ::PreprocessingResultType::OcclusionMask))
+            target.m_occlusionMaskPtr = CopyMask(source.m_occlusionMaskPtr, area);
+        if (requested(OFIQ::PreprocessingResultType::LandmarkedRegion))
+            target.m_landmarkedRegionPtr = CopyMask(source.m_landmarkedRegionPtr, area);
+    }
+
+    ResultCache::ResultCache(size_t capacity, const std::string& directory, uint64_t configurationHash)
+        : m_capacity{std::max<size_t>(capacity, 1)}, m_directory{directory}, m_configurationHash{configurationHash}
+    {
+        if (!m_directory.empty())
+        {
+            std::error_code error;
+            fs::create_directories(m_directory, error);
+        }
+    }
+
+    std::unique_ptr<ResultCache> ResultCache::FromConfiguration(const Configuration& config)
+    {
+        double capacity = 0;
+        if (!config.GetNumber(m_paramCapacity, capacity) || capacity < 1)
+            return nullptr;
+
+        std::string directory;
+        if (config.GetString(m_paramDirectory, directory) && !directory.empty() &&
+            fs::path(directory).is_relative())
+            directory = (fs::path(config.getDataDir()) / directory).string();
+
+        return std::make_unique<ResultCache>(static_cast<size_t>(capacity), directory, config.GetHash());
+    }
+
+    uint64_t ResultCache::Key(const OFIQ::Image& image) const
+    {
+        const uint16_t header[3] = {image.width, image.height, image.depth};
+        uint64_t hash = hashBytes(header, sizeof(header), m_configurationHash);
+        return hashBytes(image.data.get(), image.size(), hash);
+    }
+
+    bool ResultCache::Find(uint64_t key, uint32_t preprocessingMask, Entry& entry, size_t area)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            if (preprocessingMask != 0)
+                return false;
+            Entry loaded;
+            if (!Load(key, loaded.assessment))
+                return false;
+            entry = loaded;
+            m_entries.emplace_front(key, std::move(loaded));
+            m_index[key] = m_entries.begin();
+            if (m_entries.size() > m_capacity)
+            {
+                m_index.erase(m_entries.back().first);
+                m_entries.pop_back();
+            }
+            return true;
+        }
+
+        const Entry& cached = it->second->second;
+        if ((cached.preprocessingMask & preprocessingMask) != preprocessingMask)
+            return false;
+
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        entry.assessment = cached.assessment;
+        entry.preprocessingMask = preprocessingMask;
+        CopyPreprocessingResult(cached.preprocessingResult, preprocessingMask, area, entry.preprocessingResult);
+        return true;
+    }
+
+    void ResultCache::Insert(uint64_t key, Entry entry)
+    {
+        const bool persisted = m_index.contains(key);
+        if (persisted)
+        {
+            m_entries.erase(m_index[key]);
+            m_index.erase(key);
+        }
+        else
+            Store(key, entry.assessment);
+
+        m_entries.emplace_front(key, std::move(entry));
+        m_index[key] = m_entries.begin();
+        if (m_entries.size() > m_capacity)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    std::string ResultCache::FilePath(uint64_t key) const
+    {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".txt";
+        return (fs::path(m_directory) / name.str()).string();
+    }
+
+    bool ResultCache::Load(uint64_t key, OFIQ::FaceImageQualityAssessment& assessment) const
+    {
+        if (m_directory.empty())
+            return false;
+
+        std::ifstream file(FilePath(key));
+        std::string header;
+        if (!std::getline(file, header) || header != fileHeader)
+            return false;
+
+        uint64_t storedKey = 0;
+        int detector = 0;
+        auto& box = assessment.boundingBox;
+        file >> std::hex >> storedKey >> std::dec >> box.xleft >> box.ytop >> box.width >> box.height >> detector;
+        if (!file || storedKey != key)
+            return false;
+        box.faceDetector = static_cast<OFIQ::FaceDetectorType>(detector);
+
+        int measure = 0;
+        int code = 0;
+        OFIQ::QualityMeasureResult result;
+        while (file >> measure)
+        {
+            if (!ReadScore(file, result.rawScore) || !ReadScore(file, result.scalar) || !(file >> code))
+                return false;
+            result.code = static_cast<OFIQ::QualityMeasureReturnCode>(code);
+            assessment.qAssessments[static_cast<OFIQ::QualityMeasure>(measure)] = result;
+        }
+        return file.eof();
+    }
+
+    void ResultCache::Store(uint64_t key, const OFIQ::FaceImageQualityAssessment& assessment) const
+    {
+        if (m_directory.empty())
+            return;
+
+        const std::string path = FilePath(key);
+        // unique per writer since several processes may share the directory
+        const std::string temporaryPath = path + "." + std::to_string(std::random_device{}()) + ".tmp";
+        std::error_code error;
+        {
+            std::ofstream file(temporaryPath, std::ios::trunc);
+            const auto& box = assessment.boundingBox;
+            file << fileHeader << "\n"
+                << std::hex << key << std::dec << " " << box.xleft << " " << box.ytop << " "
+                << box.width << " " << box.height << " " << static_cast<int>(box.faceDetector) << "\n"
+                << std::setprecision(17);
+            for (const auto& [measure, result] : assessment.qAssessments)
+            {
+                file << static_cast<int>(measure) << " ";
+                WriteScore(file, result.rawScore);
+                file << " ";
+                WriteScore(file, result.scalar);
+                file << " " << static_cast<int>(result.code) << "\n";
+            }
+            if (!file)
+            {
+                file.close();
+                fs::remove(temporaryPath, error);
+                return;
+            }
+        }
+
+        fs::rename(temporaryPath, path, error);
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file RoiMask.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "RoiMask.h"
+#include <opencv2/imgproc.hpp>
+
+namespace OFIQ_LIB
+{
+    RoiMask::RoiMask(const cv::Size& imageSize, const cv::Rect& roi, const cv::Mat& data)
+        : m_imageSize{imageSize},
+          m_roi{roi & cv::Rect(cv::Point(0, 0), imageSize)}
+    {
+        if (data.empty())
+        {
+            m_data = cv::Mat::zeros(m_roi.size(), CV_8UC1);
+        }
+        else
+        {
+            CV_Assert(data.type() == CV_8UC1 && data.size() == m_roi.size());
+            m_data = data;
+        }
+    }
+
+    RoiMask RoiMask::FromMat(const cv::Mat& mask)
+    {
+        CV_Assert(mask.type() == CV_8UC1);
+        cv::Rect roi = cv::boundingRect(mask);
+        return RoiMask(mask.size(), roi, mask(roi).clone());
+    }
+
+    RoiMask RoiMask::FromConvexPolygon(const cv::Size& imageSize, std::vector<cv::Point2i> polygon)
+    {
+        RoiMask mask(imageSize, cv::boundingRect(polygon));
+        if (mask.empty())
+            return mask;
+        const cv::Point offset = mask.roi().tl();
+        for (auto& p : polygon)
+        {
+            p -= offset;
+        }
+        cv::fillConvexPoly(mask.m_data, polygon, cv::Scalar(1));
+        return mask;
+    }
+
+    RoiMask RoiMask::FromPolygons(const cv::Size& imageSize, const std::vector<std::vector<cv::Point2i>>& polygons)
+    {
+        cv::Rect boundingBox;
+        for (const auto& polygon : polygons)
+        {
+            boundingBox |= cv::boundingRect(polygon);
+        }
+        RoiMask mask(imageSize, boundingBox);
+        if (mask.empty())
+            return mask;
+        cv::fillPoly(mask.m_data, polygons, cv::Scalar(1), cv::LINE_8, 0, -mask.roi().tl());
+        return mask;
+    }
+
+    cv::Mat RoiMask::toMat() const
+    {
+        cv::Mat mask = cv::Mat::zeros(m_imageSize, CV_8UC1);
+        if (!empty())
+            m_data.copyTo(mask(m_roi));
+        return mask;
+    }
+
+    int RoiMask::countNonZero() const
+    {
+        return empty() ? 0 : cv::countNonZero(m_data);
+    }
+
+    int RoiMask::countIntersection(const cv::Mat& mask) const
+    {
+        CV_Assert(mask.type() == CV_8UC1 && mask.size() == m_imageSize);
+        int count = 0;
+        for (int y = 0; y < m_roi.height; y++)
+        {
+            const uchar* own = m_data.ptr<uchar>(y);
+            const uchar* other = mask.ptr<uchar>(m_roi.y + y) + m_roi.x;
+            for (int x = 0; x < m_roi.width; x++)
+            {
+                count += (own[x] != 0) & (other[x] != 0);
+            }
+        }
+        return count;
+    }
+
+    int RoiMask::countIntersection(const RoiMask& other) const
+    {
+        CV_Assert(other.m_imageSize == m_imageSize);
+        const cv::Rect common = m_roi & other.m_roi;
+        int count = 0;
+        for (int y = common.y; y < common.y + common.height; y++)
+        {
+            const uchar* own = m_data.ptr<uchar>(y - m_roi.y) + (common.x - m_roi.x);
+            const uchar* rhs = other.m_data.ptr<uchar>(y - other.m_roi.y) + (common.x - other.m_roi.x);
+            for (int x = 0; x < common.width; x++)
+            {
+                count += (own[x] != 0) & (rhs[x] != 0);
+            }
+        }
+        return count;
+    }
+
+    int RoiMask::countDifference(const cv::Mat& mask) const
+    {
+        return countNonZero() - countIntersection(mask);
+    }
+}
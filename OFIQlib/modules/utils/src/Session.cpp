@@ -25,15 +25,70 @@
  */
 
 #include "Session.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
 
 namespace OFIQ_LIB
 {
     
     std::string Session::GenerateId() const
     {
-        static int sessionCounter = 0;
-        sessionCounter += 1;
-        return std::to_string(sessionCounter);
+        // sessions are created concurrently by the workers of AsyncInterface
+        static std::atomic<uint64_t> sessionCounter{ 0 };
+        return std::to_string(sessionCounter.fetch_add(1) + 1);
+    }
+
+    const cv::Mat& Session::getImageBGR() const
+    {
+        if (m_imageBGR.empty())
+            m_imageBGR = copyToCvImage(m_image);
+        return m_imageBGR;
+    }
+
+    const cv::Mat& Session::getImageGray() const
+    {
+        if (m_imageGray.empty())
+        {
+            if (m_image.depth == 24)
+                cv::cvtColor(getImageBGR(), m_imageGray, cv::COLOR_BGR2GRAY);
+            else
+                m_imageGray = copyToCvImage(m_image, true);
+        }
+        return m_imageGray;
+    }
+
+    bool Session::reportPreprocessingResult(
+        OFIQ::PreprocessingResultType i_type, const OFIQ::FaceImageQualityPreprocessingResult& i_result)
+    {
+        if (isCancelled())
+            return false;
+        if (hasPreprocessingProgress())
+            m_cancelled = !m_progress->onPreprocessingResult(i_type, i_result);
+        return !m_cancelled;
+    }
+
+    bool Session::reportMeasureResult(OFIQ::QualityMeasure i_measure)
+    {
+        if (isCancelled())
+            return false;
+        if (m_progress == nullptr || !m_progress->onMeasureResult)
+            return true;
+        if (const auto* result = m_qualityResults.find(i_measure); result != nullptr)
+            m_cancelled = !m_progress->onMeasureResult(i_measure, *result);
+        return !m_cancelled;
+    }
+
+    bool Session::isCancelled() const
+    {
+        return m_cancelled || (m_interruption != nullptr && m_interruption->isInterrupted());
+    }
+
+    OFIQ::ReturnCode Session::cancellationCode() const
+    {
+        if (m_cancelled || m_interruption == nullptr)
+            return OFIQ::ReturnCode::Cancelled;
+        return m_interruption->reason();
     }
 
     void Session::setDetectedFaces(const std::vector<OFIQ::BoundingBox>& i_boundingBoxes) {
@@ -92,6 +147,7 @@ namespace OFIQ_LIB
 
     void Session::setAlignedFaceLandmarkedRegion(const cv::Mat& i_alignedFaceRegion) {
         m_alignedFacelandmarkedRegion = i_alignedFaceRegion.clone();
+        m_alignedFacelandmarkedRegionRoi = RoiMask::FromMat(m_alignedFacelandmarkedRegion);
     }
 
     cv::Mat Session::getAlignedFaceLandmarkedRegion() const
@@ -99,9 +155,20 @@ namespace OFIQ_LIB
         return m_alignedFacelandmarkedRegion.clone();
     }
 
+    void Session::setAlignedFaceLandmarkedRegion(const RoiMask& i_alignedFaceRegion) {
+        m_alignedFacelandmarkedRegionRoi = i_alignedFaceRegion;
+        m_alignedFacelandmarkedRegion = i_alignedFaceRegion.toMat();
+    }
+
+    const RoiMask& Session::getAlignedFaceLandmarkedRegionRoi() const
+    {
+        return m_alignedFacelandmarkedRegionRoi;
+    }
+
     void Session::setFaceParsingImage(const cv::Mat& i_parsingImage)
     {
         m_faceParsingImage = i_parsingImage.clone();
+        m_faceParsingClassCounts.reset();
     }
 
     cv::Mat Session::getFaceParsingImage() const
@@ -109,6 +176,18 @@ namespace OFIQ_LIB
         return m_faceParsingImage.clone();
     }
 
+    void Session::setFaceParsingClassCounts(std::shared_ptr<const ClassCounts> i_classCounts)
+    {
+        m_faceParsingClassCounts = std::move(i_classCounts);
+    }
+
+    const ClassCounts& Session::getFaceParsingClassCounts() const
+    {
+        if (!m_faceParsingClassCounts)
+            m_faceParsingClassCounts = std::make_shared<const ClassCounts>(ClassCounts::FromImage(m_faceParsingImage));
+        return *m_faceParsingClassCounts;
+    }
+
     void Session::setFaceOcclusionSegmentationImage(const cv::Mat& i_segmentationImage)
     {
         m_faceOcclusionSegmentationImage = i_segmentationImage.clone();
@@ -119,4 +198,33 @@ namespace OFIQ_LIB
         return m_faceOcclusionSegmentationImage.clone();
     }
 
-}
\ No newline at end of file
+    static bool IsSameLandmarks(const OFIQ::FaceLandmarks& a, const OFIQ::FaceLandmarks& b)
+    {
+        return a.type == b.type &&
+               std::equal(
+                   a.landmarks.begin(), a.landmarks.end(),
+                   b.landmarks.begin(), b.landmarks.end(),
+                   [](const OFIQ::LandmarkPoint& p, const OFIQ::LandmarkPoint& q)
+                   { return p.x == q.x && p.y == q.y; });
+    }
+
+    bool Session::findFaceMask(
+        const OFIQ::FaceLandmarks& i_landmarks, const cv::Size& i_size, float i_alpha, RoiMask& o_mask) const
+    {
+        for (const auto& entry : m_faceMasks)
+        {
+            if (entry.size == i_size && entry.alpha == i_alpha && IsSameLandmarks(entry.landmarks, i_landmarks))
+            {
+                o_mask = entry.mask;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Session::storeFaceMask(
+        const OFIQ::FaceLandmarks& i_landmarks, const cv::Size& i_size, float i_alpha, const RoiMask& i_mask)
+    {
+        m_faceMasks.push_back({i_landmarks, i_size, i_alpha, i_mask});
+    }
+}
@@ -116,8 +116,8 @@ namespace OFIQ_LIB
     void CalculateReferencePoints(const OFIQ::FaceLandmarks& landmarks, OFIQ::LandmarkPoint& leftEyeCenter, OFIQ::LandmarkPoint& rightEyeCenter,
         double& interEyeDistance, double& eyeMouthDistance)
     {
-        auto leftEyePoints = PartExtractor::getFacePart(landmarks, FaceParts::LEFT_EYE_CORNERS);
-        auto rightEyePoints = PartExtractor::getFacePart(landmarks, FaceParts::RIGHT_EYE_CORNERS);
+        auto leftEyePoints = PartExtractor::getFacePartPoints(landmarks, FaceParts::LEFT_EYE_CORNERS);
+        auto rightEyePoints = PartExtractor::getFacePartPoints(landmarks, FaceParts::RIGHT_EYE_CORNERS);
         leftEyeCenter = FaceMeasures::GetMiddle(leftEyePoints);
         rightEyeCenter = FaceMeasures::GetMiddle(rightEyePoints);
 
@@ -38,6 +38,7 @@
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -109,6 +110,111 @@ namespace OFIQ_LIB
         }
     }
 
+    OFIQ_EXPORT cv::Mat cropWithConstantBorder(
+        const cv::Mat& i_input_image,
+        const OFIQ::BoundingBox& i_bb)
+    {
+        const cv::Rect roi(i_bb.xleft, i_bb.ytop, i_bb.width, i_bb.height);
+        const cv::Rect inside = roi & cv::Rect(0, 0, i_input_image.cols, i_input_image.rows);
+        if (inside == roi)
+        {
+            return i_input_image(roi);
+        }
+        if (inside.empty())
+        {
+            return cv::Mat::zeros(roi.size(), i_input_image.type());
+        }
+
+        // pad only the part of the region lying inside the image
+        cv::Mat croppedImage;
+        cv::copyMakeBorder(
+            i_input_image(inside),
+            croppedImage,
+            inside.y - roi.y,
+            roi.br().y - inside.br().y,
+            inside.x - roi.x,
+            roi.br().x - inside.br().x,
+            cv::BORDER_CONSTANT,
+            cv::Scalar(0, 0, 0));
+        return croppedImage;
+    }
+
+    OFIQ_EXPORT cv::Mat cropAndResizeWithConstantBorder(
+        const cv::Mat& i_input_image,
+        const OFIQ::BoundingBox& i_bb,
+        int i_width,
+        int i_height)
+    {
+        cv::Mat resizedImage;
+        cv::resize(
+            cropWithConstantBorder(i_input_image, i_bb),
+            resizedImage,
+            cv::Size(i_width, i_height),
+            0,
+            0,
+            cv::INTER_LINEAR);
+        return resizedImage;
+    }
+
+    OFIQ_EXPORT void packPlanarNormalized(
+        const cv::Mat& i_input_image,
+        float i_scale,
+        float i_offset,
+        float* o_tensor)
+    {
+        if (i_input_image.type() != CV_8UC3)
+            throw OFIQError(
+                OFIQ::ReturnCode::UnknownError,
+                "Planar packing requires an 8-bit three-channel image");
+
+        const int cols = i_input_image.cols;
+        const size_t planeSize = static_cast<size_t>(i_input_image.rows) * cols;
+        for (int y = 0; y < i_input_image.rows; y++)
+        {
+            const uchar* src = i_input_image.ptr<uchar>(y);
+            float* dst0 = o_tensor + static_cast<size_t>(y) * cols;
+            float* dst1 = dst0 + planeSize;
+            float* dst2 = dst1 + planeSize;
+            int x = 0;
+#if CV_SIMD
+            const cv::v_float32 vScale = cv::vx_setall_f32(i_scale);
+            const cv::v_float32 vOffset = cv::vx_setall_f32(i_offset);
+            const int step = cv::v_uint8::nlanes;
+            const int quarter = cv::v_float32::nlanes;
+            for (; x <= cols - step; x += step)
+            {
+                cv::v_uint8 c0;
+                cv::v_uint8 c1;
+                cv::v_uint8 c2;
+                cv::v_load_deinterleave(src + 3 * x, c0, c1, c2);
+                float* dsts[3] = { dst0 + x, dst1 + x, dst2 + x };
+                const cv::v_uint8* channels[3] = { &c0, &c1, &c2 };
+                for (int c = 0; c < 3; c++)
+                {
+                    cv::v_uint16 lo16;
+                    cv::v_uint16 hi16;
+                    cv::v_expand(*channels[c], lo16, hi16);
+                    cv::v_uint32 parts[4];
+                    cv::v_expand(lo16, parts[0], parts[1]);
+                    cv::v_expand(hi16, parts[2], parts[3]);
+                    for (int k = 0; k < 4; k++)
+                    {
+                        const cv::v_float32 value = cv::v_cvt_f32(cv::v_reinterpret_as_s32(parts[k]));
+                        cv::v_store(dsts[c] + k * quarter, cv::v_fma(value, vScale, vOffset));
+                    }
+                }
+            }
+            cv::vx_cleanup();
+#endif
+            for (; x < cols; x++)
+            {
+                dst0[x] = src[3 * x] * i_scale + i_offset;
+                dst1[x] = src[3 * x + 1] * i_scale + i_offset;
+                dst2[x] = src[3 * x + 2] * i_scale + i_offset;
+            }
+        }
+    }
+
     OFIQ_EXPORT OFIQ::BoundingBox makeSquareBoundingBox(const OFIQ::BoundingBox& i_bb)
     {
 
@@ -186,6 +292,43 @@ namespace OFIQ_LIB
         return (size_t)std::distance(faceRects.begin(), idxBiggestFace);
     }
 
+    OFIQ_EXPORT uint64_t hashBytes(const void* data, size_t size, uint64_t seed)
+    {
+        constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+        const auto mix = [](uint64_t hash, uint64_t word)
+        {
+            word *= prime2;
+            word = (word << 31) | (word >> 33);
+            hash ^= word * prime1;
+            return ((hash << 27) | (hash >> 37)) * prime1 + 0x85EBCA77C2B2AE63ULL;
+        };
+
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = seed ^ (size * prime1);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            // assemble the word byte by byte to be independent of alignment and endianness
+            uint64_t word = 0;
+            for (int b = 7; b >= 0; b--)
+                word = (word << 8) | bytes[i + b];
+            hash = mix(hash, word);
+        }
+        uint64_t tail = 0;
+        for (size_t b = size; b > i; b--)
+            tail = (tail << 8) | bytes[b - 1];
+        hash = mix(hash, tail);
+
+        // final avalanche
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= 0x165667B19E3779F9ULL;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
     OFIQ_EXPORT OFIQ::Image MakeGreyImage(uint16_t width, uint16_t height)
     {
         std::shared_ptr<uint8_t[]> data{new uint8_t[width * height]};
@@ -218,9 +361,71 @@ namespace OFIQ_LIB
         const OFIQ::Image& faceImage,
         const OFIQ::FaceLandmarks& faceLandmarks,
         OFIQ::FaceLandmarks& alignedFaceLandmarks,
-        cv::Mat& transformationMatrix)
+        cv::Mat& transformationMatrix,
+        AlignmentMethod method)
+    {
+        return alignImage(
+            copyToCvImage(faceImage), faceLandmarks, alignedFaceLandmarks, transformationMatrix, method);
+    }
+
+    OFIQ_EXPORT cv::Mat estimateSimilarityTransform(const cv::Mat& srcPoints, const cv::Mat& dstPoints)
+    {
+        const int n = srcPoints.rows;
+        if (n < 2 || dstPoints.rows != n || srcPoints.cols != 2 || dstPoints.cols != 2)
+            throw OFIQError(
+                OFIQ::ReturnCode::UnknownError,
+                "Similarity estimation requires at least two point correspondences");
+
+        double srcMeanX = 0;
+        double srcMeanY = 0;
+        double dstMeanX = 0;
+        double dstMeanY = 0;
+        for (int i = 0; i < n; i++)
+        {
+            srcMeanX += srcPoints.at<float>(i, 0);
+            srcMeanY += srcPoints.at<float>(i, 1);
+            dstMeanX += dstPoints.at<float>(i, 0);
+            dstMeanY += dstPoints.at<float>(i, 1);
+        }
+        srcMeanX /= n;
+        srcMeanY /= n;
+        dstMeanX /= n;
+        dstMeanY /= n;
+
+        // a = sum <s, d>, b = sum s x d; the optimal scaled rotation is (a, b) / sum |s|^2
+        double a = 0;
+        double b = 0;
+        double srcNorm = 0;
+        for (int i = 0; i < n; i++)
+        {
+            const double sx = srcPoints.at<float>(i, 0) - srcMeanX;
+            const double sy = srcPoints.at<float>(i, 1) - srcMeanY;
+            const double dx = dstPoints.at<float>(i, 0) - dstMeanX;
+            const double dy = dstPoints.at<float>(i, 1) - dstMeanY;
+            a += sx * dx + sy * dy;
+            b += sx * dy - sy * dx;
+            srcNorm += sx * sx + sy * sy;
+        }
+        if (srcNorm <= 0)
+            throw OFIQError(
+                OFIQ::ReturnCode::UnknownError,
+                "Similarity estimation requires distinct source points");
+
+        const double scaledCos = a / srcNorm;
+        const double scaledSin = b / srcNorm;
+        cv::Mat transformationMatrix = (cv::Mat_<double>(2, 3) <<
+            scaledCos, -scaledSin, dstMeanX - (scaledCos * srcMeanX - scaledSin * srcMeanY),
+            scaledSin, scaledCos, dstMeanY - (scaledSin * srcMeanX + scaledCos * srcMeanY));
+        return transformationMatrix;
+    }
+
+    OFIQ_EXPORT cv::Mat alignImage(
+        const cv::Mat& bgrCvImage,
+        const OFIQ::FaceLandmarks& faceLandmarks,
+        OFIQ::FaceLandmarks& alignedFaceLandmarks,
+        cv::Mat& transformationMatrix,
+        AlignmentMethod method)
     {
-        cv::Mat bgrCvImage = copyToCvImage(faceImage);
         int nose;
         int leftMouth;
         int rightMouth;
@@ -261,7 +466,10 @@ namespace OFIQ_LIB
         std::array<float, 10> refData = {251, 272, 364, 272, 308, 336, 262, 402, 355, 402};
         auto refPoints = cv::Mat(5, 2, CV_32F, refData.data());
         // calculate transformation matrix and warp image
-        transformationMatrix = cv::estimateAffinePartial2D(srcPoints, refPoints, {}, cv::LMEDS);
+        if (method == AlignmentMethod::Umeyama)
+            transformationMatrix = estimateSimilarityTransform(srcPoints, refPoints);
+        else
+            transformationMatrix = cv::estimateAffinePartial2D(srcPoints, refPoints, {}, cv::LMEDS);
         cv::Mat bgrAlignedImage;
         cv::warpAffine(bgrCvImage, bgrAlignedImage, transformationMatrix, cv::Size(616, 616));
         for (auto landmark : faceLandmarks.landmarks)
@@ -269,6 +477,7 @@ namespace OFIQ_LIB
             landmarks.push_back({ static_cast<float>(landmark.x), static_cast<float>(landmark.y) });
         }
         cv::transform(landmarks, alignedLandmarks, transformationMatrix);
+        alignedFaceLandmarks.landmarks.reserve(alignedFaceLandmarks.landmarks.size() + alignedLandmarks.size());
         for (const auto& p : alignedLandmarks)
         {
             OFIQ::LandmarkPoint landmark;
@@ -282,9 +491,9 @@ namespace OFIQ_LIB
     OFIQ_EXPORT void calculateEyeCenter(
         const OFIQ::FaceLandmarks& faceLandmarks, Point2f& leftEyeCenter, Point2f& rightEyeCenter)
     {
-        auto leftEyePoints = PartExtractor::getFacePart(faceLandmarks, FaceParts::LEFT_EYE_CORNERS);
+        auto leftEyePoints = PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::LEFT_EYE_CORNERS);
         auto rightEyePoints =
-            PartExtractor::getFacePart(faceLandmarks, FaceParts::RIGHT_EYE_CORNERS);
+            PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::RIGHT_EYE_CORNERS);
         assert(leftEyePoints.size() == 2 && rightEyePoints.size() == 2);
         leftEyeCenter.x = static_cast<float>(round(leftEyePoints[0].x + 0.5 * (leftEyePoints[1].x - leftEyePoints[0].x)));
         leftEyeCenter.y = static_cast<float>(round(leftEyePoints[0].y + 0.5 * (leftEyePoints[1].y - leftEyePoints[0].y)));
@@ -297,7 +506,7 @@ namespace OFIQ_LIB
         Point2f leftEyeCenter;
         Point2f rightEyeCenter;
         calculateEyeCenter(faceLandmarks, leftEyeCenter, rightEyeCenter);
-        OFIQ::Landmarks chinLandmarks = PartExtractor::getFacePart(faceLandmarks, FaceParts::CHIN);
+        auto chinLandmarks = PartExtractor::getFacePartPoints(faceLandmarks, FaceParts::CHIN);
         cv::Point2f eyeMidpoint(static_cast<float>((leftEyeCenter.x + rightEyeCenter.x) / 2.0), 
             static_cast<float>((leftEyeCenter.y + rightEyeCenter.y) / 2.0));
         cv::Point2f chin(chinLandmarks[0].x, chinLandmarks[0].y);
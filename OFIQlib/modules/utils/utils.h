@@ -86,6 +86,54 @@ namespace OFIQ_LIB
         Point2i & o_translation_vector
         );
 
+    /**
+     * @brief Crops a region from an image as if the image was surrounded by a black border of infinite size.
+     * @details The result equals padding the image with <code>cv::BORDER_CONSTANT</code> such that the region
+     * fits and cropping it afterwards. Only the region is touched: if it lies inside the image, a view on
+     * the input image is returned without copying; otherwise only the region is allocated.
+     * 
+     * @param i_input_image Input image.
+     * @param i_bb Region to be cropped; may exceed the image borders.
+     * @return cv::Mat Cropped region of dimension i_bb.width x i_bb.height.
+     */
+    OFIQ_EXPORT cv::Mat cropWithConstantBorder(
+        const cv::Mat& i_input_image,
+        const OFIQ::BoundingBox& i_bb);
+
+    /**
+     * @brief Crops a region from an image as done by \link cropWithConstantBorder \endlink and resizes it
+     * using bilinear interpolation.
+     * 
+     * @param i_input_image Input image.
+     * @param i_bb Region to be cropped; may exceed the image borders.
+     * @param i_width Width of the resized region.
+     * @param i_height Height of the resized region.
+     * @return cv::Mat Cropped and resized region.
+     */
+    OFIQ_EXPORT cv::Mat cropAndResizeWithConstantBorder(
+        const cv::Mat& i_input_image,
+        const OFIQ::BoundingBox& i_bb,
+        int i_width,
+        int i_height);
+
+    /**
+     * @brief Converts an interleaved 8-bit three-channel image into normalized planar float values.
+     * @details Each pixel value x is written as x * i_scale + i_offset into the plane of its channel,
+     * i.e., the output is laid out as channel, height, width (CHW) as expected by the networks. The channel
+     * order of the input is kept. Rows are processed with SIMD instructions where available, so the
+     * input may be a non-continuous ROI.
+     * 
+     * @param i_input_image Input image of type <code>CV_8UC3</code>.
+     * @param i_scale Factor applied to each pixel value.
+     * @param i_offset Offset added after scaling.
+     * @param o_tensor Preallocated output of at least 3 * rows * cols elements.
+     */
+    OFIQ_EXPORT void packPlanarNormalized(
+        const cv::Mat& i_input_image,
+        float i_scale,
+        float i_offset,
+        float* o_tensor);
+
     /**
      * @brief This function converts a non-squarred bounding box into an squarred one. The side length is defined by the greater one of height or width.
      * 
@@ -113,6 +161,30 @@ namespace OFIQ_LIB
      */
     OFIQ_EXPORT cv::Mat copyToCvImage(const OFIQ::Image& sourceImage, bool asGrayImage = false);
 
+    /**
+     * @brief Method used to estimate the similarity transformation of the face alignment.
+     */
+    enum class AlignmentMethod
+    {
+        /** Robust estimation with <code>cv::estimateAffinePartial2D</code> using least median of squares (default). */
+        LMEDS,
+        /** Closed-form least-squares similarity (Umeyama) computed by \link estimateSimilarityTransform \endlink. */
+        Umeyama
+    };
+
+    /**
+     * @brief Computes the least-squares similarity transformation (rotation, uniform scale and translation)
+     * mapping the source points onto the destination points.
+     * @details Solves the problem of Umeyama (1991) in closed form: for two-dimensional points the rotation
+     * and scale follow directly from the cross-covariance of the centred point sets, so no iteration,
+     * random sampling or singular value decomposition is required and the result is deterministic.
+     * 
+     * @param srcPoints Source points as n x 2 matrix of type <code>CV_32F</code>.
+     * @param dstPoints Destination points as n x 2 matrix of type <code>CV_32F</code>.
+     * @return cv::Mat Affine 2 x 3 transformation matrix of type <code>CV_64F</code>.
+     */
+    OFIQ_EXPORT cv::Mat estimateSimilarityTransform(const cv::Mat& srcPoints, const cv::Mat& dstPoints);
+
     /**
      * @brief This function transforms a face image so that the position of the eyes, nose and mouth are roughly at a pre-defined position. Face alignment is the translation, rotation and scaling of the image to do this.
      * 
@@ -120,13 +192,33 @@ namespace OFIQ_LIB
      * @param faceLandmarks  Face landmarks, based on the face represented in the input image.
      * @param alignedFaceLandmarks  Face landmarks of the aligned face image.
      * @param transformationMatrix Transformation matrix used to transform the landmarks.
+     * @param method Method used to estimate the transformation matrix.
      * @return cv::Mat Aligned face image with a resolution of 616x616.
      */
     OFIQ_EXPORT cv::Mat alignImage(
         const OFIQ::Image& faceImage,
         const OFIQ::FaceLandmarks& faceLandmarks,
         OFIQ::FaceLandmarks& alignedFaceLandmarks,
-        cv::Mat& transformationMatrix);
+        cv::Mat& transformationMatrix,
+        AlignmentMethod method = AlignmentMethod::LMEDS);
+
+    /**
+     * @brief Same as \link alignImage(const OFIQ::Image&, const OFIQ::FaceLandmarks&, OFIQ::FaceLandmarks&, cv::Mat&) \endlink
+     * but operating on an image that has already been converted to BGR format.
+     * 
+     * @param bgrImage Input image in BGR format.
+     * @param faceLandmarks  Face landmarks, based on the face represented in the input image.
+     * @param alignedFaceLandmarks  Face landmarks of the aligned face image.
+     * @param transformationMatrix Transformation matrix used to transform the landmarks.
+     * @param method Method used to estimate the transformation matrix.
+     * @return cv::Mat Aligned face image with a resolution of 616x616.
+     */
+    OFIQ_EXPORT cv::Mat alignImage(
+        const cv::Mat& bgrImage,
+        const OFIQ::FaceLandmarks& faceLandmarks,
+        OFIQ::FaceLandmarks& alignedFaceLandmarks,
+        cv::Mat& transformationMatrix,
+        AlignmentMethod method = AlignmentMethod::LMEDS);
 
     /**
      * @brief Based on face landmarks the center of the left and right eye are computed.
@@ -156,6 +248,18 @@ namespace OFIQ_LIB
      * @return float Computed distance.
      */
     OFIQ_EXPORT float tmetric(const OFIQ::FaceLandmarks& faceLandmarks);
+
+    /**
+     * @brief Computes a fast non-cryptographic 64-bit hash of a byte buffer.
+     * @details The buffer is processed in words of 8 bytes; the result does not depend on the platform
+     * and can be stored persistently.
+     * 
+     * @param data Pointer to the buffer.
+     * @param size Number of bytes of the buffer.
+     * @param seed Start value, e.g. the hash of preceding data.
+     * @return uint64_t Hash value.
+     */
+    OFIQ_EXPORT uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,249 @@
+/**
+ * @file OFIQAsync.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "ofiq_async.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace OFIQ
+{
+    struct AsyncInterface::Impl
+    {
+        /**
+         * @brief Image waiting for assessment together with the function receiving its result.
+         */
+        struct Request
+        {
+            /** @brief Image to be assessed. */
+            Image image;
+            /** @brief Function receiving the result. */
+            AssessmentCallback complete;
+            /** @brief Callbacks receiving intermediate results; not set if not requested. */
+            std::optional<AssessmentProgress> progress;
+            /** @brief Token and deadline aborting the assessment; not set if not requested. */
+            std::optional<AssessmentCancellation> cancellation;
+        };
+
+        /** @brief Number of worker threads. */
+        size_t numberOfWorkers;
+        /** @brief Maximum number of queued requests. */
+        size_t queueCapacity;
+
+        /** @brief One implementation per worker; implementations are not shared between threads. */
+        std::vector<std::shared_ptr<Interface>> implementations;
+        /** @brief Worker threads; empty until initialized. Filled while holding the mutex. */
+        std::vector<std::thread> workers;
+
+        /** @brief Requests waiting for a worker. */
+        std::deque<Request> queue;
+        /** @brief Guards the queue, the list of workers and the stopping flag. */
+        std::mutex mutex;
+        /** @brief Signalled when a request has been queued or the workers are stopped. */
+        std::condition_variable requestAvailable;
+        /** @brief Signalled when a request has been taken from the queue or the workers are stopped. */
+        std::condition_variable spaceAvailable;
+        /** @brief Set when the workers are stopped. */
+        bool stopping = false;
+
+        /**
+         * @brief Queues a request, blocking while the queue is full.
+         * @details If the workers are not running, the request is completed immediately with an error.
+         * @param request Request to be queued.
+         */
+        void Enqueue(Request request);
+
+        /**
+         * @brief Loop of a worker thread assessing queued requests.
+         * @param implementation Implementation owned by the worker.
+         */
+        void Work(Interface& implementation);
+
+        /**
+         * @brief Completes the queued requests and joins the workers.
+         */
+        void Stop();
+    };
+
+    void AsyncInterface::Impl::Enqueue(Request request)
+    {
+        {
+            std::unique_lock lock(mutex);
+            if (!workers.empty() && !stopping)
+            {
+                spaceAvailable.wait(lock, [this]() { return queue.size() < queueCapacity || stopping; });
+                if (!stopping)
+                {
+                    queue.push_back(std::move(request));
+                    requestAvailable.notify_one();
+                    return;
+                }
+            }
+        }
+
+        AsyncAssessmentResult result;
+        result.status = ReturnStatus(ReturnCode::UnknownError, "The asynchronous interface is not running");
+        request.complete(std::move(result));
+    }
+
+    void AsyncInterface::Impl::Work(Interface& implementation)
+    {
+        for (;;)
+        {
+            Request request;
+            {
+                std::unique_lock lock(mutex);
+                requestAvailable.wait(lock, [this]() { return !queue.empty() || stopping; });
+                // queued requests are completed before stopping
+                if (queue.empty())
+                    return;
+                request = std::move(queue.front());
+                queue.pop_front();
+            }
+            spaceAvailable.notify_one();
+
+            AsyncAssessmentResult result;
+            try
+            {
+                if (request.progress.has_value())
+                    result.status = implementation.vectorQualityWithProgress(request.image, result.assessment, *request.progress);
+                else if (request.cancellation.has_value())
+                    result.status = implementation.vectorQualityWithCancellation(request.image, result.assessment, *request.cancellation);
+                else
+                    result.status = implementation.vectorQuality(request.image, result.assessment);
+            }
+            catch (const std::exception& e)
+            {
+                result.status = ReturnStatus(ReturnCode::UnknownError, e.what());
+            }
+            catch (...)
+            {
+                result.status = ReturnStatus(ReturnCode::UnknownError, "Unknown exception during the assessment");
+            }
+
+            try
+            {
+                request.complete(std::move(result));
+            }
+            catch (...)
+            {
+                // exceptions of callbacks must not terminate the worker
+            }
+        }
+    }
+
+    void AsyncInterface::Impl::Stop()
+    {
+        std::vector<std::thread> stoppedWorkers;
+        {
+            std::scoped_lock lock(mutex);
+            stopping = true;
+            stoppedWorkers.swap(workers);
+        }
+        requestAvailable.notify_all();
+        spaceAvailable.notify_all();
+        for (auto& worker : stoppedWorkers)
+            worker.join();
+    }
+
+    OFIQ_EXPORT AsyncInterface::AsyncInterface(size_t numberOfWorkers, size_t queueCapacity)
+        : m_impl{std::make_unique<Impl>()}
+    {
+        m_impl->numberOfWorkers = std::max<size_t>(numberOfWorkers, 1);
+        m_impl->queueCapacity = std::max<size_t>(queueCapacity, 1);
+    }
+
+    OFIQ_EXPORT AsyncInterface::~AsyncInterface()
+    {
+        m_impl->Stop();
+    }
+
+    OFIQ_EXPORT ReturnStatus AsyncInterface::initialize(const std::string& configDir, const std::string& configFileName)
+    {
+        const ReturnStatus alreadyInitialized(
+            ReturnCode::UnknownError, "The asynchronous interface is already initialized");
+        {
+            std::scoped_lock lock(m_impl->mutex);
+            if (!m_impl->workers.empty())
+                return alreadyInitialized;
+        }
+
+        // the implementations are initialized without holding the lock since loading the models takes long
+        std::vector<std::shared_ptr<Interface>> implementations;
+        for (size_t i = 0; i < m_impl->numberOfWorkers; i++)
+        {
+            auto implementation = Interface::getImplementation();
+            if (auto status = implementation->initialize(configDir, configFileName);
+                status.code != ReturnCode::Success)
+                return status;
+            implementations.push_back(std::move(implementation));
+        }
+
+        // submit() reads the list of workers under the lock; the workers wait for it before taking requests
+        std::scoped_lock lock(m_impl->mutex);
+        if (!m_impl->workers.empty())
+            return alreadyInitialized;
+        m_impl->implementations = std::move(implementations);
+        for (const auto& implementation : m_impl->implementations)
+            m_impl->workers.emplace_back(&Impl::Work, m_impl.get(), std::ref(*implementation));
+
+        return ReturnStatus(ReturnCode::Success);
+    }
+
+    OFIQ_EXPORT std::future<AsyncAssessmentResult> AsyncInterface::submit(const Image& image)
+    {
+        auto promise = std::make_shared<std::promise<AsyncAssessmentResult>>();
+        auto future = promise->get_future();
+        m_impl->Enqueue({image, [promise](AsyncAssessmentResult&& result) { promise->set_value(std::move(result)); }, std::nullopt, std::nullopt});
+        return future;
+    }
+
+    OFIQ_EXPORT void AsyncInterface::submit(const Image& image, AssessmentCallback callback)
+    {
+        m_impl->Enqueue({image, std::move(callback), std::nullopt, std::nullopt});
+    }
+
+    OFIQ_EXPORT void AsyncInterface::submit(const Image& image, AssessmentProgress progress, AssessmentCallback callback)
+    {
+        m_impl->Enqueue({image, std::move(callback), std::move(progress), std::nullopt});
+    }
+
+    OFIQ_EXPORT std::future<AsyncAssessmentResult> AsyncInterface::submit(const Image& image, AssessmentCancellation cancellation)
+    {
+        auto promise = std::make_shared<std::promise<AsyncAssessmentResult>>();
+        auto future = promise->get_future();
+        m_impl->Enqueue({
+            image,
+            [promise](AsyncAssessmentResult&& result) { promise->set_value(std::move(result)); },
+            std::nullopt,
+            std::move(cancellation)});
+        return future;
+    }
+}
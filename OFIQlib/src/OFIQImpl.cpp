@@ -29,6 +29,8 @@
 #include "ofiq_lib_impl.h"
 #include "OFIQError.h"
 #include "FaceMeasures.h"
+#include "GeometryPlan.h"
+#include "Interruption.h"
 #include "utils.h"
 #include "image_io.h"
 #include <chrono>
@@ -45,8 +47,11 @@ ReturnStatus OFIQImpl::initialize(const std::string& configDir, const std::strin
     try
     {
         this->config = std::make_unique<Configuration>(configDir, configFilename);
+        m_alignmentMethod = GeometryPlan::GetAlignmentMethod(*config);
         CreateNetworks();
         m_executorPtr = CreateExecutor();
+        m_resultCache = ResultCache::FromConfiguration(*config);
+        m_preprocessingStore = PreprocessingStore::FromConfiguration(*config);
     }
     catch (const OFIQError & ex)
     {
@@ -92,178 +97,369 @@ ReturnStatus OFIQImpl::scalarQuality(const OFIQ::Image& face, double& quality)
     return ReturnStatus(ReturnCode::Success);
 }
 
-OFIQ::ReturnStatus OFIQImpl::preprocess(Session& session)
+OFIQ::ReturnStatus OFIQImpl::preprocess(Session& session, PreprocessingStage stage)
 {
     try
     {
         log("performing preprocessing:\n");
+        ThrowIfCancelled(session);
 
         std::chrono::time_point<hrclock> tic;
+        bool computeFaceGeometry = stage != PreprocessingStage::Segmentations;
+        bool computeSegmentations = stage != PreprocessingStage::FaceGeometry;
 
-        log("\t1. detectFaces ");
-        tic = hrclock::now();
+        // artifacts stored by a previous run replace the networks; missing ones are computed
+        if (m_preprocessingStore != nullptr && m_preprocessingStore->GetMode() == PreprocessingStore::Mode::Read)
+        {
+            const auto loaded = m_preprocessingStore->Load(session, computeFaceGeometry, computeSegmentations);
+            if (loaded.faceGeometry)
+            {
+                log("\tloaded face geometry ");
+                computeFaceGeometry = false;
+                computeLandmarkedRegion(session);
+                ReportPreprocessingResult(session, PreprocessingResultType::Faces);
+                ReportPreprocessingResult(session, PreprocessingResultType::Landmarks);
+                ReportPreprocessingResult(session, PreprocessingResultType::LandmarkedRegion);
+            }
+            if (loaded.segmentations)
+            {
+                log("\tloaded segmentations ");
+                computeSegmentations = false;
+                ReportPreprocessingResult(session, PreprocessingResultType::Segmentation);
+                ReportPreprocessingResult(session, PreprocessingResultType::OcclusionMask);
+            }
+        }
+
+        if (computeFaceGeometry)
+        {
+            // results supplied by the caller replace the corresponding stages
+            const auto& preprocessingInput = session.preprocessingInput();
+
+            log("\t1. detectFaces ");
+            tic = hrclock::now();
+
+            std::vector<OFIQ::BoundingBox> faces = preprocessingInput.m_faces.empty() ?
+                networks->faceDetector->detectFaces(session) :
+                FaceDetectorInterface::RankFaces(session, preprocessingInput.m_faces);
+            if (faces.empty())
+            {
+                log("\n\tNo faces were detected, abort preprocessing\n");
+                throw OFIQError(ReturnCode::FaceDetectionError, "No faces were detected");
+            }
+            log(std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hrclock::now() - tic).count()) + std::string(" ms "));
+
+            session.setDetectedFaces(faces);
+            ReportPreprocessingResult(session, PreprocessingResultType::Faces);
+            log("2. estimatePose ");
+            tic = hrclock::now();
+
+            session.setPose(preprocessingInput.m_pose.has_value() ?
+                *preprocessingInput.m_pose :
+                networks->poseEstimator->estimatePose(session));
 
-        std::vector<OFIQ::BoundingBox> faces = networks->faceDetector->detectFaces(session);
-        if (faces.empty())
+            log(std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hrclock::now() - tic).count()) + std::string(" ms "));
+
+            log("3. extractLandmarks ");
+            tic = hrclock::now();
+
+            if (preprocessingInput.m_landmarks.type == OFIQ::LandmarkType::LM_98)
+            {
+                if (preprocessingInput.m_landmarks.landmarks.size() != 98)
+                {
+                    throw OFIQError(
+                        ReturnCode::FaceLandmarkExtractionError,
+                        "Supplied landmarks of type LM_98 must consist of 98 points");
+                }
+                session.setLandmarks(preprocessingInput.m_landmarks);
+            }
+            else
+                session.setLandmarks(networks->landmarkExtractor->extractLandmarks(session));
+
+            log(std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hrclock::now() - tic).count()) + std::string(" ms "));
+            ReportPreprocessingResult(session, PreprocessingResultType::Landmarks);
+
+            log("4. alignFaceImage ");
+            tic = hrclock::now();
+            // aligned face requires the landmarks of the face thus it must come after the landmark extraction.
+            alignFaceImage(session);
+            log(std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hrclock::now() - tic).count()) + std::string(" ms "));
+
+            log("5. getAlignedFaceMask ");
+            tic = hrclock::now();
+            computeLandmarkedRegion(session);
+            log(std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hrclock::now() - tic).count()) + std::string(" ms "));
+            ReportPreprocessingResult(session, PreprocessingResultType::LandmarkedRegion);
+        }
+
+        if (computeSegmentations)
         {
-            log("\n\tNo faces were detected, abort preprocessing\n");
-            throw OFIQError(ReturnCode::FaceDetectionError, "No faces were detected");
+            log("6. getSegmentationMask ");
+            tic = hrclock::now();
+            // segmentation results for face_parsing
+            session.setFaceParsingImage(OFIQ_LIB::copyToCvImage(
+                networks->segmentationExtractor->GetMask(
+                    session,
+                    OFIQ_LIB::modules::segmentations::SegmentClassLabels::face),
+                true));
+            session.setFaceParsingClassCounts(networks->segmentationExtractor->GetClassCounts());
+            log(std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hrclock::now() - tic).count()) + std::string(" ms "));
+            ReportPreprocessingResult(session, PreprocessingResultType::Segmentation);
+
+            log("7. getFaceOcclusionMask ");
+            tic = hrclock::now();
+            session.setFaceOcclusionSegmentationImage(OFIQ_LIB::copyToCvImage(
+                networks->faceOcclusionExtractor->GetMask(
+                    session,
+                    OFIQ_LIB::modules::segmentations::SegmentClassLabels::face),
+                true));
+            log(std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hrclock::now() - tic).count()) + std::string(" ms "));
+            ReportPreprocessingResult(session, PreprocessingResultType::OcclusionMask);
         }
-        log(std::to_string(
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                hrclock::now() - tic).count()) + std::string(" ms "));
-
-        session.setDetectedFaces(faces);
-        log("2. estimatePose ");
-        tic = hrclock::now();
-
-        session.setPose(networks->poseEstimator->estimatePose(session));
-
-        log(std::to_string(
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                hrclock::now() - tic).count()) + std::string(" ms "));
-
-        log("3. extractLandmarks ");
-        tic = hrclock::now();
-
-        session.setLandmarks(networks->landmarkExtractor->extractLandmarks(session));
-
-        log(std::to_string(
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                hrclock::now() - tic).count()) + std::string(" ms "));
-
-        log("4. alignFaceImage ");
-        tic = hrclock::now();
-        // aligned face requires the landmarks of the face thus it must come after the landmark extraction.
-        alignFaceImage(session);
-        log(std::to_string(
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                hrclock::now() - tic).count()) + std::string(" ms "));
-
-        log("5. getSegmentationMask ");
-        tic = hrclock::now();
-        // segmentation results for face_parsing
-        session.setFaceParsingImage(OFIQ_LIB::copyToCvImage(
-            networks->segmentationExtractor->GetMask(
-                session,
-                OFIQ_LIB::modules::segmentations::SegmentClassLabels::face),
-            true));
-        log(std::to_string(
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                hrclock::now() - tic).count()) + std::string(" ms "));
-
-        log("6. getFaceOcclusionMask ");
-        tic = hrclock::now();
-        session.setFaceOcclusionSegmentationImage(OFIQ_LIB::copyToCvImage(
-            networks->faceOcclusionExtractor->GetMask(
-                session,
-                OFIQ_LIB::modules::segmentations::SegmentClassLabels::face),
-            true));
-        log(std::to_string(
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                hrclock::now() - tic).count()) + std::string(" ms "));
-
-        static const std::string alphaParamPath = "params.measures.FaceRegion.alpha";
-        double alpha = 0.0f;
-        if( !this->config->GetNumber(alphaParamPath, alpha))
-            alpha = 0.0f;
-
-        log("7. getAlignedFaceMask ");
-        tic = hrclock::now();
-
-        session.setAlignedFaceLandmarkedRegion(
-            OFIQ_LIB::modules::landmarks::FaceMeasures::GetFaceMask(
-                session.getAlignedFaceLandmarks(),
-                session.getAlignedFace().rows,
-                session.getAlignedFace().cols,
-                (float)alpha
-            )
-        );
-        log(std::to_string(
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                hrclock::now() - tic).count()) + std::string(" ms "));
+
+        if (m_preprocessingStore != nullptr && m_preprocessingStore->GetMode() == PreprocessingStore::Mode::Write)
+            m_preprocessingStore->Save(session);
 
         log("\npreprocessing finished\n");
     }
     catch (const OFIQError& e)
     {
         log("OFIQError: " + std::string(e.what()) + "\n");
-        // for some (compound) measurements we need to manually set 
-        // the return code to FailureToAssess 
-        for (const auto& measure : m_executorPtr->GetMeasures())
-        {
-            auto qualityMeasure = measure->GetQualityMeasure();
-            switch (qualityMeasure)
-            {
-            case QualityMeasure::Luminance:
-                session.assessment().qAssessments[QualityMeasure::LuminanceMean] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                session.assessment().qAssessments[QualityMeasure::LuminanceVariance] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                break;
-            case QualityMeasure::CropOfTheFaceImage:
-                session.assessment().qAssessments[QualityMeasure::LeftwardCropOfTheFaceImage] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                session.assessment().qAssessments[QualityMeasure::RightwardCropOfTheFaceImage] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                session.assessment().qAssessments[QualityMeasure::MarginBelowOfTheFaceImage] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                session.assessment().qAssessments[QualityMeasure::MarginAboveOfTheFaceImage] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                break;
-            case QualityMeasure::HeadPose:
-                session.assessment().qAssessments[QualityMeasure::HeadPoseYaw] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                session.assessment().qAssessments[QualityMeasure::HeadPosePitch] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                session.assessment().qAssessments[QualityMeasure::HeadPoseRoll] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                break;
-            default:
-                session.assessment().qAssessments[measure->GetQualityMeasure()] =
-                { 0, -1, OFIQ::QualityMeasureReturnCode::FailureToAssess };
-                break;
-            }
-        }
+        // an inference terminated on cancellation fails with the error code of its network
+        if (session.isCancelled())
+            return FinishCancelledAssessment(session);
+        // results of measures already computed (i.e. gates of the cascade) are kept,
+        // all others are set to FailureToAssess
+        m_executorPtr->SetMissingResults(session, OFIQ::QualityMeasureReturnCode::FailureToAssess);
         return { e.whatCode(), e.what() };
     }
 
     return ReturnStatus(ReturnCode::Success);
 }
 
+void OFIQImpl::ReportPreprocessingResult(Session& session, PreprocessingResultType type) const
+{
+    FaceImageQualityPreprocessingResult result;
+    if (session.hasPreprocessingProgress())
+        getPreprocessingResults(session, result, static_cast<uint32_t>(type));
+    session.reportPreprocessingResult(type, result);
+    ThrowIfCancelled(session);
+}
+
+void OFIQImpl::ThrowIfCancelled(const Session& session)
+{
+    if (session.isCancelled())
+        throw OFIQError(session.cancellationCode(), "The assessment was aborted during preprocessing");
+}
+
+ReturnStatus OFIQImpl::FinishCancelledAssessment(Session& session) const
+{
+    const auto code = session.cancellationCode();
+    const std::string message = code == ReturnCode::DeadlineExceeded ?
+        "The deadline of the assessment has passed" : "The assessment was cancelled";
+    log("\t" + message + "\n");
+    m_executorPtr->SetMissingResults(session, OFIQ::QualityMeasureReturnCode::Skipped);
+    session.publishQualityResults();
+    return { code, message };
+}
+
 void OFIQImpl::alignFaceImage(Session& session) const
 {
     auto landmarks = session.getLandmarks();
     OFIQ::FaceLandmarks alignedFaceLandmarks;
     alignedFaceLandmarks.type = landmarks.type;
     cv::Mat transformationMatrix;
-    cv::Mat alignedBGRimage = alignImage(session.image(), landmarks, alignedFaceLandmarks, transformationMatrix);
+    cv::Mat alignedBGRimage = alignImage(
+        session.getImageBGR(), landmarks, alignedFaceLandmarks, transformationMatrix, m_alignmentMethod);
 
     session.setAlignedFace(alignedBGRimage);
     session.setAlignedFaceLandmarks(alignedFaceLandmarks);
     session.setAlignedFaceTransformationMatrix(transformationMatrix);
 }
 
+void OFIQImpl::computeLandmarkedRegion(Session& session) const
+{
+    static const std::string alphaParamPath = "params.measures.FaceRegion.alpha";
+    double alpha = 0.0f;
+    if( !this->config->GetNumber(alphaParamPath, alpha))
+        alpha = 0.0f;
+
+    const cv::Size alignedSize = session.getAlignedFace().size();
+    session.setAlignedFaceLandmarkedRegion(
+        OFIQ_LIB::modules::landmarks::FaceMeasures::GetCachedFaceMask(
+            session,
+            session.getAlignedFaceLandmarks(),
+            alignedSize.height,
+            alignedSize.width,
+            (float)alpha
+        )
+    );
+}
+
 ReturnStatus OFIQImpl::performAssessment(Session& session)
 {
-    ReturnStatus retStatus = preprocess(session);
+    // the segmentation networks are only run if a selected measure reads their results
+    const bool requiresSegmentations = m_executorPtr->RequiresSegmentations(session);
+
+    if (!m_executorPtr->HasCascade())
+    {
+        ReturnStatus retStatus = preprocess(
+            session, requiresSegmentations ? PreprocessingStage::All : PreprocessingStage::FaceGeometry);
+        if (retStatus.code != ReturnCode::Success)
+        {
+            session.publishQualityResults();
+            return retStatus;
+        }
+
+        log("execute assessments:\n");
+        m_executorPtr->ExecuteAll(session);
+        if (session.isCancelled())
+            return FinishCancelledAssessment(session);
+        session.publishQualityResults();
+
+        return ReturnStatus(ReturnCode::Success);
+    }
+
+    // cascade: the gates are evaluated on the face geometry before the segmentations are computed
+    ReturnStatus retStatus = preprocess(session, PreprocessingStage::FaceGeometry);
     if (retStatus.code != ReturnCode::Success)
+    {
+        session.publishQualityResults();
         return retStatus;
+    }
+
+    log("execute cascade gates:\n");
+    const bool passedGates = m_executorPtr->ExecuteGates(session);
+    if (session.isCancelled())
+        return FinishCancelledAssessment(session);
+    if (!passedGates)
+    {
+        m_executorPtr->SetMissingResults(session, OFIQ::QualityMeasureReturnCode::Skipped);
+        session.publishQualityResults();
+        return ReturnStatus(ReturnCode::Success);
+    }
+
+    if (requiresSegmentations)
+    {
+        retStatus = preprocess(session, PreprocessingStage::Segmentations);
+        if (retStatus.code != ReturnCode::Success)
+        {
+            session.publishQualityResults();
+            return retStatus;
+        }
+    }
 
     log("execute assessments:\n");
-    m_executorPtr->ExecuteAll(session);
+    m_executorPtr->ExecuteRemaining(session);
+    if (session.isCancelled())
+        return FinishCancelledAssessment(session);
+    session.publishQualityResults();
 
-    if (retStatus.code != ReturnCode::Success)
+    return ReturnStatus(ReturnCode::Success);
+}
+
+ReturnStatus OFIQImpl::AssessCached(
+    const OFIQ::Image& image,
+    OFIQ::FaceImageQualityAssessment& assessments,
+    OFIQ::FaceImageQualityPreprocessingResult* preprocessingResult,
+    uint32_t resultRequestsMask)
+{
+    auto assess = [&]()
+    {
+        auto session = Session(image, assessments);
+        ReturnStatus retStatus = performAssessment(session);
+        if (retStatus.code == ReturnCode::Success && resultRequestsMask != 0)
+            retStatus = getPreprocessingResults(session, *preprocessingResult, resultRequestsMask);
         return retStatus;
+    };
 
-    return ReturnStatus(ReturnCode::Success);
+    if (m_resultCache == nullptr)
+        return assess();
+
+    const auto key = m_resultCache->Key(image);
+    const auto area = static_cast<size_t>(image.width) * image.height;
+    if (ResultCache::Entry entry; m_resultCache->Find(key, resultRequestsMask, entry, area))
+    {
+        log("result cache hit\n");
+        for (const auto& [measure, result] : entry.assessment.qAssessments)
+            assessments.qAssessments[measure] = result;
+        assessments.boundingBox = entry.assessment.boundingBox;
+        if (resultRequestsMask != 0)
+            ResultCache::CopyPreprocessingResult(entry.preprocessingResult, resultRequestsMask, area, *preprocessingResult);
+        return ReturnStatus(ReturnCode::Success);
+    }
+
+    ReturnStatus retStatus = assess();
+    if (retStatus.code == ReturnCode::Success)
+    {
+        ResultCache::Entry entry;
+        entry.assessment = assessments;
+        entry.preprocessingMask = resultRequestsMask;
+        if (resultRequestsMask != 0)
+            ResultCache::CopyPreprocessingResult(*preprocessingResult, resultRequestsMask, area, entry.preprocessingResult);
+        m_resultCache->Insert(key, std::move(entry));
+    }
+    return retStatus;
 }
 
 ReturnStatus OFIQImpl::vectorQuality(
     const OFIQ::Image& image,
     OFIQ::FaceImageQualityAssessment& assessments)
+{
+    return AssessCached(image, assessments, nullptr, 0);
+}
+
+ReturnStatus OFIQImpl::vectorQuality(
+    const OFIQ::Image& image,
+    OFIQ::FaceImageQualityAssessment& assessments,
+    const OFIQ::QualityMeasureSelection& measures)
 {
     auto session = Session(image, assessments);
+    session.setMeasureSelection(measures);
+    return performAssessment(session);
+}
+
+ReturnStatus OFIQImpl::vectorQualityWithPreprocessingInput(
+    const OFIQ::Image& image,
+    OFIQ::FaceImageQualityAssessment& assessments,
+    const OFIQ::FaceImageQualityPreprocessingInput& preprocessingInput)
+{
+    auto session = Session(image, assessments);
+    session.setPreprocessingInput(preprocessingInput);
+    return performAssessment(session);
+}
+
+ReturnStatus OFIQImpl::vectorQualityWithProgress(
+    const OFIQ::Image& image,
+    OFIQ::FaceImageQualityAssessment& assessments,
+    const OFIQ::AssessmentProgress& progress)
+{
+    auto session = Session(image, assessments);
+    session.setProgress(progress);
+    return performAssessment(session);
+}
+
+ReturnStatus OFIQImpl::vectorQualityWithCancellation(
+    const OFIQ::Image& image,
+    OFIQ::FaceImageQualityAssessment& assessments,
+    const OFIQ::AssessmentCancellation& cancellation)
+{
+    const Interruption interruption(cancellation);
+    auto session = Session(image, assessments);
+    session.setInterruption(interruption);
     return performAssessment(session);
 }
 
@@ -273,11 +469,25 @@ ReturnStatus OFIQImpl::vectorQualityWithPreprocessingResults(
     FaceImageQualityPreprocessingResult& preprocessingResult,
     uint32_t resultRequestsMask)
 {
-    auto session = Session(image, assessments);
-    if (ReturnStatus retStatus = performAssessment(session);
-        retStatus.code != ReturnCode::Success)
-        return retStatus;
-    return getPreprocessingResults(session, preprocessingResult, resultRequestsMask);
+    return AssessCached(image, assessments, &preprocessingResult, resultRequestsMask);
+}
+
+ReturnStatus OFIQImpl::rescoreScalars(
+    OFIQ::QualityMeasure measure,
+    const std::vector<double>& rawScores,
+    std::vector<double>& scalars)
+{
+    if (!m_executorPtr)
+        return {ReturnCode::UnknownError, "OFIQ has not been initialized"};
+    if (rawScores.size() != scalars.size())
+        return {ReturnCode::UnknownError, "Numbers of native quality scores and quality component values differ"};
+
+    if (!m_executorPtr->RescoreScalars(measure, rawScores, scalars))
+    {
+        return {ReturnCode::NotImplemented,
+            "Quality component values of " + std::string(MeasureName(measure)) + " are not computed by a configured quality mapping"};
+    }
+    return ReturnStatus(ReturnCode::Success);
 }
 
 ReturnStatus OFIQImpl::getPreprocessingResults(
@@ -292,8 +502,11 @@ ReturnStatus OFIQImpl::getPreprocessingResults(
     int height = session.image().height;
     int area = width * height;
     auto originalTransform = session.getAlignedFaceTransformationMatrix().clone();
-    auto alignedToOriginalTransform = originalTransform.clone();
-    cv::invertAffineTransform(alignedToOriginalTransform, alignedToOriginalTransform);
+    // faces and landmarks are also requested before the face has been aligned
+    cv::Mat alignedToOriginalTransform;
+    if (resultRequestsMask & static_cast<uint32_t>(PreprocessingResultType::OcclusionMask) ||
+        resultRequestsMask & static_cast<uint32_t>(PreprocessingResultType::LandmarkedRegion))
+        cv::invertAffineTransform(originalTransform, alignedToOriginalTransform);
 
     // Access faces
     if (resultRequestsMask & static_cast<uint32_t>(PreprocessingResultType::Faces))
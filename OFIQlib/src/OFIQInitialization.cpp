@@ -32,7 +32,6 @@
 #include "ofiq_lib_impl.h"
 #include "OFIQError.h"
 #include "NeuronalNetworkContainer.h"
-#include <magic_enum.hpp>
 
 namespace OFIQ_LIB
 {
@@ -49,9 +48,9 @@ namespace OFIQ_LIB
         std::vector<OFIQ::QualityMeasure> measures;
         for (auto measure_name : measure_names)
         {
-            auto measure = magic_enum::enum_cast<OFIQ::QualityMeasure>(measure_name);
-            if (measure.has_value())
-                measures.emplace_back(measure.value());
+            auto measure = MeasureFromName(measure_name);
+            if (measure != OFIQ::QualityMeasure::NotSet)
+                measures.emplace_back(measure);
             else
                 invalid_names.emplace_back(measure_name);
         }
@@ -62,14 +61,39 @@ namespace OFIQ_LIB
         const std::vector<OFIQ::QualityMeasure>& measures,
         const Configuration& configuration)
     {
-        std::vector<std::unique_ptr<Measure>> measure_instances;
-        for (auto m : measures)
+        return MeasureFactory::CreateMeasures(measures, configuration);
+    }
+
+    std::vector<CascadeGate> read_cascade_gates(const Configuration& configuration)
+    {
+        static const std::string gatesParamPath = "params.cascade.gates";
+        static const std::string thresholdsParamPath = "params.cascade.thresholds.";
+
+        std::vector<CascadeGate> gates;
+        std::vector<std::string> gate_names;
+        if (!configuration.GetStringList(gatesParamPath, gate_names))
+            return gates;
+
+        for (const auto& gate_name : gate_names)
         {
-            measure_instances.emplace_back(
-                MeasureFactory::CreateMeasure(
-                    m, configuration));
+            auto measure = MeasureFromName(gate_name);
+            if (measure == OFIQ::QualityMeasure::NotSet)
+            {
+                throw OFIQError(
+                    OFIQ::ReturnCode::NotImplemented,
+                    "invalid measure name detected in cascade gates: " + gate_name);
+            }
+
+            double minimumScalar = 0;
+            if (!configuration.GetNumber(thresholdsParamPath + gate_name, minimumScalar))
+            {
+                throw OFIQError(
+                    OFIQ::ReturnCode::NotImplemented,
+                    "missing threshold for cascade gate: " + gate_name);
+            }
+            gates.push_back({ measure, minimumScalar });
         }
-        return measure_instances;
+        return gates;
     }
 
     std::unique_ptr<Executor> OFIQImpl::CreateExecutor()
@@ -98,8 +122,10 @@ namespace OFIQ_LIB
 
         // initialise measures
         
-        return std::make_unique<Executor>(create_measures(
+        auto executor = std::make_unique<Executor>(create_measures(
             measures, *config));
+        executor->SetCascade(read_cascade_gates(*config));
+        return executor;
     }
 
     void OFIQImpl::CreateNetworks()
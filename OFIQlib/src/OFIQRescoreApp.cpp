@@ -0,0 +1,354 @@
+/**
+ * @file OFIQRescoreApp.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+
+#if defined _WIN32 && defined OFIQ_EXPORTS
+#undef OFIQ_EXPORTS
+#endif
+
+#include "ofiq_lib.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <magic_enum.hpp>
+#include <filesystem>
+#include <chrono>
+
+constexpr int SUCCESS = 0;
+constexpr int FAILURE = 1;
+
+
+namespace fs = std::filesystem;
+
+using namespace std;
+using namespace OFIQ;
+
+/**
+ * @brief Results of OFIQSampleApp read column by column.
+ */
+struct ResultTable
+{
+    /**
+     * @brief Column names of the header line.
+     */
+    std::vector<std::string> header;
+
+    /**
+     * @brief Cells indexed by column and row.
+     */
+    std::vector<std::vector<std::string>> columns;
+
+    /**
+     * @brief Number of rows below the header line.
+     */
+    size_t rowCount = 0;
+};
+
+std::vector<std::string> splitLine(const std::string& line)
+{
+    std::vector<std::string> cells;
+    std::istringstream iss(line);
+    std::string cell;
+    while (std::getline(iss, cell, ';'))
+        cells.push_back(cell);
+    return cells;
+}
+
+bool readResultTable(std::istream& is, ResultTable& table)
+{
+    std::string line;
+    if (!std::getline(is, line))
+        return false;
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+    table.header = splitLine(line);
+    table.columns.resize(table.header.size());
+
+    while (std::getline(is, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        auto cells = splitLine(line);
+        cells.resize(table.header.size());
+        for (size_t c = 0; c < cells.size(); c++)
+            table.columns[c].push_back(std::move(cells[c]));
+        table.rowCount++;
+    }
+    return true;
+}
+
+bool parseColumn(const std::vector<std::string>& cells, std::vector<double>& values, double missingValue)
+{
+    values.resize(cells.size());
+    for (size_t r = 0; r < cells.size(); r++)
+    {
+        // rows of images that could not be assessed have no values
+        if (cells[r].empty())
+        {
+            values[r] = missingValue;
+            continue;
+        }
+        try
+        {
+            values[r] = std::stod(cells[r]);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+string formatValue(double val)
+{
+    // same format as the output of OFIQSampleApp
+    if (round(val) == val)
+        return to_string((int)val);
+    return to_string(val);
+}
+
+int rescoreResultTable(
+    const std::shared_ptr<Interface>& implPtr,
+    ResultTable& table)
+{
+    const std::string scalarSuffix = ".scalar";
+    std::vector<double> rawScores;
+    std::vector<double> scalars;
+
+    for (size_t rawColumn = 0; rawColumn < table.header.size(); rawColumn++)
+    {
+        const auto& name = table.header[rawColumn];
+        auto measure = magic_enum::enum_cast<QualityMeasure>(name);
+        if (!measure.has_value())
+            continue;
+        auto scalarColumn = std::find(table.header.begin(), table.header.end(), name + scalarSuffix);
+        if (scalarColumn == table.header.end())
+            continue;
+        auto& scalarCells = table.columns[std::distance(table.header.begin(), scalarColumn)];
+
+        if (!parseColumn(table.columns[rawColumn], rawScores, 0.0) || !parseColumn(scalarCells, scalars, -1.0))
+        {
+            cerr << "[ERROR] Invalid values in the columns of " << name << "." << endl;
+            return FAILURE;
+        }
+
+        auto ret = implPtr->rescoreScalars(measure.value(), rawScores, scalars);
+        if (ret.code == ReturnCode::NotImplemented)
+        {
+            cerr << "[INFO] Keeping stored values of " << name << "." << endl;
+            continue;
+        }
+        if (ret.code != ReturnCode::Success)
+        {
+            cerr << "[ERROR] rescoreScalars() returned error: " << ret.code << "." << endl
+                 << ret.info << endl;
+            return FAILURE;
+        }
+
+        for (size_t r = 0; r < scalars.size(); r++)
+        {
+            if (!scalarCells[r].empty())
+                scalarCells[r] = formatValue(scalars[r]);
+        }
+    }
+
+    return SUCCESS;
+}
+
+void writeResultTable(const ResultTable& table, std::ostream& os)
+{
+    for (const auto& name : table.header)
+        os << name << ';';
+    os << std::endl;
+
+    for (size_t r = 0; r < table.rowCount; r++)
+    {
+        for (size_t c = 0; c < table.columns.size(); c++)
+        {
+            if (c > 0)
+                os << ';';
+            os << table.columns[c][r];
+        }
+        os << std::endl;
+    }
+}
+
+
+void usage(const string& executable)
+{
+    cerr << "Usage: " << executable
+         << " [-c <configDir|configPath>]" << endl
+         << " [-o <outputFile>]" << endl
+         << " -i <resultFile>" << endl
+         << " [-cf <configFile>]"
+         << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) // If only the exec is specified
+    {
+        usage(argv[0]);
+        return FAILURE;
+    }
+
+    fs::path configDir;
+    fs::path outputFile;
+    fs::path inputFile;
+    fs::path configFile;
+
+    for (int i = 1; i < argc; i++)
+    {
+        fs::path* argument = nullptr;
+        std::string argumentName;
+        if (strcmp(argv[i], "-c") == 0)
+        {
+            argument = &configDir;
+            argumentName = "<configDir|configPath>";
+        }
+        else if (strcmp(argv[i], "-o") == 0)
+        {
+            argument = &outputFile;
+            argumentName = "<outputFile>";
+        }
+        else if (strcmp(argv[i], "-i") == 0)
+        {
+            argument = &inputFile;
+            argumentName = "<resultFile>";
+        }
+        else if (strcmp(argv[i], "-cf") == 0)
+        {
+            argument = &configFile;
+            argumentName = "<configFile>";
+        }
+        else
+        {
+            usage(argv[0]);
+            cerr << "[ERROR] Unrecognized flag: " << argv[i] << endl;
+            return FAILURE;
+        }
+
+        if (!argument->empty())
+        {
+            usage(argv[0]);
+            cerr << "[ERROR] " << argumentName << " already specified." << endl;
+            return FAILURE;
+        }
+        if (i + 1 >= argc)
+        {
+            usage(argv[0]);
+            cerr << "[ERROR] specification of " << argumentName << " missing." << endl;
+            return FAILURE;
+        }
+        *argument = fs::path(argv[++i]);
+    }
+
+    // Check completeness of arguments
+    if (inputFile.empty())
+    {
+        usage(argv[0]);
+        cerr << "[ERROR] <resultFile> must be specified." << endl;
+        return FAILURE;
+    }
+
+    if (!fs::is_regular_file(inputFile))
+    {
+        cerr << "[ERROR] -i must specify an existing result file of OFIQSampleApp." << endl;
+        return FAILURE;
+    }
+
+    if (configDir.empty())
+    {
+        configDir = fs::path("config");
+    }
+
+    if (fs::is_regular_file(configDir))
+    {
+        if (!configFile.empty())
+        {
+            cerr << "[ERROR] Redundant specification of configuration file." << endl;
+            return FAILURE;
+        }
+
+        configFile = configDir.filename();
+        configDir = configDir.parent_path();
+    }
+
+    ResultTable table;
+    {
+        std::ifstream ifs(inputFile);
+        if (!readResultTable(ifs, table))
+        {
+            cerr << "[ERROR] Could not read '" << inputFile.filename() << "'." << endl;
+            return FAILURE;
+        }
+    }
+
+    /* Get implementation pointer */
+    auto implPtr = Interface::getImplementation();
+    /* Initialization */
+    auto ret = implPtr->initialize(
+        configDir.generic_string(),
+        configFile.generic_string());
+    if (ret.code != ReturnCode::Success)
+    {
+        cerr << "[ERROR] initialize() returned error: " << ret.code << "." << endl
+             << ret.info << endl;
+        return FAILURE;
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    if (rescoreResultTable(implPtr, table) != SUCCESS)
+        return FAILURE;
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    cerr << "[INFO] Rescoring " << table.rowCount << " results took: " << elapsed.count() << "ms" << endl;
+
+    // write to output file
+    if (!outputFile.empty())
+    {
+        std::ofstream ofs(outputFile);
+        if (!ofs.good())
+        {
+            cerr << "[ERROR] Could not open '" << outputFile.filename() << "'." << endl;
+            return FAILURE;
+        }
+        writeResultTable(table, ofs);
+    }
+    else
+    {
+        writeResultTable(table, std::cout);
+    }
+
+    return SUCCESS;
+}
@@ -1,11 +1,13 @@
 list(APPEND PUBLIC_HEADER_LIST 
 	${OFIQLIB_SOURCE_DIR}/include/ofiq_lib.h
 	${OFIQLIB_SOURCE_DIR}/include/ofiq_structs.h
+	${OFIQLIB_SOURCE_DIR}/include/ofiq_async.h
 )
 
 list(APPEND libImplementationSources 
 	${OFIQLIB_SOURCE_DIR}/src/OFIQImpl.cpp
 	${OFIQLIB_SOURCE_DIR}/src/OFIQInitialization.cpp
+	${OFIQLIB_SOURCE_DIR}/src/OFIQAsync.cpp
 )
 
 list(APPEND module_sources 
@@ -51,6 +53,12 @@ list(APPEND module_sources
 	${OFIQLIB_SOURCE_DIR}/modules/utils/src/OFIQError.cpp
 	${OFIQLIB_SOURCE_DIR}/modules/utils/src/image_io.cpp
 	${OFIQLIB_SOURCE_DIR}/modules/utils/src/image_utils.cpp
+	${OFIQLIB_SOURCE_DIR}/modules/utils/src/RoiMask.cpp
+	${OFIQLIB_SOURCE_DIR}/modules/utils/src/GeometryPlan.cpp
+	${OFIQLIB_SOURCE_DIR}/modules/utils/src/PreprocessingStore.cpp
+	${OFIQLIB_SOURCE_DIR}/modules/utils/src/ClassCounts.cpp
+	${OFIQLIB_SOURCE_DIR}/modules/utils/src/Interruption.cpp
+	${OFIQLIB_SOURCE_DIR}/modules/utils/src/ResultCache.cpp
 	${OFIQLIB_SOURCE_DIR}/modules/utils/src/Session.cpp
 	${OFIQLIB_SOURCE_DIR}/modules/utils/src/utils.cpp
 )
@@ -84,6 +92,7 @@ list(APPEND module_headers
 	${OFIQLIB_SOURCE_DIR}/modules/measures/Luminance.h
 	${OFIQLIB_SOURCE_DIR}/modules/measures/Measure.h
 	${OFIQLIB_SOURCE_DIR}/modules/measures/MeasureFactory.h
+	${OFIQLIB_SOURCE_DIR}/modules/measures/MeasureRegistry.h
 	${OFIQLIB_SOURCE_DIR}/modules/measures/MouthOcclusionPrevention.h
 	${OFIQLIB_SOURCE_DIR}/modules/measures/MouthClosed.h
 	${OFIQLIB_SOURCE_DIR}/modules/measures/NoHeadCoverings.h
@@ -106,6 +115,12 @@ list(APPEND module_headers
 	${OFIQLIB_SOURCE_DIR}/modules/utils/image_io.h
 	${OFIQLIB_SOURCE_DIR}/modules/utils/image_utils.h
 	${OFIQLIB_SOURCE_DIR}/modules/utils/NeuronalNetworkContainer.h
+	${OFIQLIB_SOURCE_DIR}/modules/utils/RoiMask.h
+	${OFIQLIB_SOURCE_DIR}/modules/utils/GeometryPlan.h
+	${OFIQLIB_SOURCE_DIR}/modules/utils/PreprocessingStore.h
+	${OFIQLIB_SOURCE_DIR}/modules/utils/ClassCounts.h
+	${OFIQLIB_SOURCE_DIR}/modules/utils/Interruption.h
+	${OFIQLIB_SOURCE_DIR}/modules/utils/ResultCache.h
 	${OFIQLIB_SOURCE_DIR}/modules/utils/Session.h
 	${OFIQLIB_SOURCE_DIR}/modules/utils/utils.h
 )
\ No newline at end of file
@@ -148,6 +148,12 @@
  *   original image prior face detection. Note, the specified value 0.2 (fixed for OFIQ) has 
  *   been determined experimentally.</td> 
  *  </tr>
+ *  <tr>
+ *   <td>fast_preprocessing</td><td>optional; if true, the network input
+ *   is resampled directly from the unpadded image instead of copying the image into
+ *   a padded buffer first. This saves memory for large images; the network input may
+ *   differ by one grey level due to interpolation. Default is false.</td>
+ *  </tr>
  * </table>
  * 
  * @subsection sec_facelandmark_cfg Configuration of the landmark extractor
@@ -201,9 +207,164 @@
  *   therefore, the measure shall be configured (even if no measure is requested that uses
  *   the pre-processing result). The path to the 
  *   [BiSeNet](https://github.com/zllrunning/face-parsing.PyTorch) model file in ONNX format 
- *  should be set using the <code>model_path</code> key.</tr>
+ *  should be set using the <code>model_path</code> key. If the optional key
+ *  <code>fused_preprocessing</code> is true (default), resizing, normalization and packing of the
+ *  network input are done in a single pass. The normalized values are looked up in a table computed
+ *  by the <code>blobFromImage</code> pre-processing, which is used if the key is false; both yield
+ *  bit-identical network inputs and therefore identical scores.</tr>
  * </table>
  * 
+ * @subsection sec_geometry_cfg Optional geometry configuration
+ * The measures \link OFIQ_LIB::modules::measures::UnifiedQualityScore UnifiedQualityScore\endlink,
+ * \link OFIQ_LIB::modules::measures::ExpressionNeutrality ExpressionNeutrality\endlink and
+ * \link OFIQ_LIB::modules::measures::CompressionArtifacts CompressionArtifacts\endlink
+ * as well as the segmentations \link OFIQ_LIB::modules::segmentations::FaceParsing FaceParsing\endlink and
+ * \link OFIQ_LIB::modules::segmentations::FaceOcclusionSegmentation FaceOcclusionSegmentation\endlink
+ * derive their network inputs by cropping and resizing the aligned 616 x 616 face image.
+ * If <code>"params"."geometry"."direct_warp"</code> is set to true, the alignment, crop and resize
+ * are composed into a single affine transform and the network input is sampled directly from
+ * the original image. This avoids intermediate images but interpolates only once, so the
+ * resulting scalar values may differ from the conformance values. Since the segmentations feed
+ * the face region, occlusion, background and luminance measures, the drift is not limited to the
+ * three network-based measures above. Default is false.
+ * 
+ * The drift of such an option is quantified with the conformance test: running
+ * <code>test_conformance_table -cf &lt;config&gt; -d &lt;report.csv&gt;</code> with a configuration
+ * enabling the option writes, per measure, the maximum and mean absolute difference of the native
+ * and scalar quality values from the conformance table as well as the number of images whose
+ * scalar value changed. The score drift of <code>direct_warp</code> has not been measured with this release,
+ * since it requires the models and the conformance test images. The drift of the network inputs has been
+ * measured by replicating both pipelines with OpenCV 4.11 on a frontal portrait scaled to inter-eye distances
+ * of 46, 92 and 184 pixels (alignment scales 2.45, 1.22 and 0.61). The table lists the absolute difference
+ * of the sampled 8 bit intensities from the chained crop and resize, before normalization.
+ * <table>
+ *  <tr><td><b>Network input</b></td><td><b>Mean</b></td><td><b>99th percentile</b></td><td><b>Maximum</b></td></tr>
+ *  <tr><td>UnifiedQualityScore (112 x 112)</td><td>0.41 - 0.45</td><td>2.0 - 3.0</td><td>9 - 15</td></tr>
+ *  <tr><td>ExpressionNeutrality (224 x 224)</td><td>0.47 - 0.49</td><td>2.6 - 3.2</td><td>11 - 14</td></tr>
+ *  <tr><td>ExpressionNeutrality (260 x 260)</td><td>0.46 - 0.48</td><td>2.5 - 3.2</td><td>14 - 19</td></tr>
+ *  <tr><td>CompressionArtifacts (248 x 248)</td><td>0.00</td><td>0</td><td>1 - 4</td></tr>
+ *  <tr><td>FaceParsing (400 x 400)</td><td>0.35 - 0.43</td><td>3.0</td><td>22 - 82</td></tr>
+ *  <tr><td>FaceOcclusionSegmentation (224 x 224)</td><td>0.39 - 0.41</td><td>3.0</td><td>13 - 20</td></tr>
+ * </table>
+ * CompressionArtifacts only crops, so its input is unchanged up to the fixed-point rounding of the sampling
+ * positions. The other inputs are resampled once instead of twice; differences above 3.2 are confined to less than
+ * 1% of the pixels.
+ * As these inputs are not bit-identical, the option must not be enabled for conformance purposes before the
+ * drift report has been produced on the full test set and all scalar differences are within the tolerance
+ * of the conformance test.
+ * 
+ * The key <code>"params"."geometry"."alignment"</code> selects how the similarity transformation
+ * of the face alignment is estimated from the five alignment points (eye centres, nose tip and mouth corners).
+ * <code>"LMEDS"</code> (default) uses the robust, randomized estimator <code>cv::estimateAffinePartial2D</code>;
+ * <code>"Umeyama"</code> uses the closed-form least-squares solution 
+ * \link OFIQ_LIB::estimateSimilarityTransform estimateSimilarityTransform\endlink, which is deterministic 
+ * and does not allocate. Both estimators agree on noise-free correspondences; on real landmarks LMEDS
+ * may discard outlying points that Umeyama weights equally, so alignment and all scores computed on the
+ * aligned image can change. The per-measure differences are obtained with the drift report of the
+ * conformance test described above (<code>test_conformance_table -cf &lt;config&gt; -d &lt;report.csv&gt;</code>).
+ * No comparison figures are published with this release; <code>"Umeyama"</code> must not be used for
+ * conformance purposes before that report has been produced on the full test set and all scalar
+ * differences are within the tolerance of the conformance test.
+ * <pre>
+ * {
+ *  ...
+ *    "params": {
+ *      "geometry": {
+ *        "direct_warp": false,
+ *        "alignment": "LMEDS"
+ *      },
+ *      ...
+ *    }
+ *  ...
+ * }
+ * </pre>
+ * 
+ * @subsection sec_cascade_cfg Optional assessment cascade
+ * Applications rejecting images that fail cheap measures can configure an ordered list of gate measures
+ * in <code>"params"."cascade"."gates"</code> together with a minimum scalar value for each of them in
+ * <code>"params"."cascade"."thresholds"</code>. The gates are evaluated right after face detection, pose estimation,
+ * landmark extraction and alignment. If the result of a gate measure is not successful or its scalar value is below
+ * the threshold, the segmentation networks and all remaining measures are not run; their results are returned with the code
+ * \link OFIQ::QualityMeasureReturnCode::Skipped QualityMeasureReturnCode::Skipped\endlink. For the compound measures
+ * <code>HeadPose</code>, <code>Luminance</code> and <code>CropOfTheFaceImage</code>, all components must pass.
+ * Gate measures must be requested (see @ref sec_requesting_measures) and must not depend on a segmentation,
+ * which excludes BackgroundUniformity, UnderExposurePrevention, OverExposurePrevention, EyesVisible, 
+ * MouthOcclusionPrevention, FaceOcclusionPrevention and NoHeadCoverings. An empty list (default) disables the cascade.
+ * <pre>
+ * {
+ *  ...
+ *    "params": {
+ *      "cascade": {
+ *        "gates": ["SingleFacePresent", "HeadPose", "InterEyeDistance"],
+ *        "thresholds": {
+ *          "SingleFacePresent": 50,
+ *          "HeadPose": 50,
+ *          "InterEyeDistance": 50
+ *        }
+ *      },
+ *      ...
+ *    }
+ *  ...
+ * }
+ * </pre>
+ * 
+ * @subsection sec_result_cache_cfg Optional result cache
+ * Applications receiving the same images repeatedly can enable a cache of assessments by setting
+ * <code>"params"."result_cache"."capacity"</code> to the number of images kept in memory. Images are identified
+ * by a 64-bit hash of their dimensions and pixel data combined with a hash of the OFIQ version, the configuration
+ * and size and modification time of the model files; on a hit,
+ * \link OFIQ_LIB::OFIQImpl::vectorQuality vectorQuality\endlink, 
+ * \link OFIQ_LIB::OFIQImpl::scalarQuality scalarQuality\endlink and
+ * \link OFIQ_LIB::OFIQImpl::vectorQualityWithPreprocessingResults vectorQualityWithPreprocessingResults\endlink
+ * return the cached results without running any network. Only successful assessments are cached; pre-processing
+ * results are cached in memory if they were requested on the first assessment of the image. If
+ * <code>"params"."result_cache"."directory"</code> is set, assessments are also written to that directory, where
+ * they are found after eviction, after a restart and by other processes using the same version, configuration
+ * and models. Since model files are identified by size and modification time rather than by content, clear the
+ * directory when models are replaced by files carrying the old time stamp. A capacity of 0 (default)
+ * disables the cache.
+ * <pre>
+ * {
+ *  ...
+ *    "params": {
+ *      "result_cache": {
+ *        "capacity": 1000,
+ *        "directory": "result_cache"
+ *      },
+ *      ...
+ *    }
+ *  ...
+ * }
+ * </pre>
+ * 
+ * @subsection sec_preprocessing_store_cfg Optional pre-processing store
+ * Re-scoring an archive after changing measure parameters or the list of measures does not require the
+ * pre-processing networks to run again. With <code>"params"."preprocessing_store"."mode"</code> set to
+ * <code>"write"</code>, the face geometry (detected faces, landmarks, pose, alignment transformation and aligned
+ * landmarks) and, if computed, the face parsing and the face occlusion mask of each image
+ * are written to one binary file per image in <code>"params"."preprocessing_store"."directory"</code>. Files are
+ * named by a hash of the image content and store the masks PNG-compressed. With the mode set to <code>"read"</code>,
+ * the stored artifacts replace face detection, landmark extraction, pose estimation, alignment and both
+ * segmentation networks; only the landmarked region of the aligned face, which depends on
+ * <code>"params"."measures"."FaceRegion"."alpha"</code>, and the measures are computed. Images not found in the store
+ * are pre-processed as usual. Each file records a hash of the settings the stored artifacts depend on: the parameters
+ * of the detector, the landmark extractor, <code>"params"."geometry"</code>, the head pose estimator and both
+ * segmentation networks, their model files and the library version. Files written with different settings are
+ * ignored, such that the affected images are pre-processed again. Files are written in the byte order of the host. The mode <code>"off"</code> (default) disables the store.
+ * <pre>
+ * {
+ *  ...
+ *    "params": {
+ *      "preprocessing_store": {
+ *        "mode": "read",
+ *        "directory": "preprocessing_store"
+ *      },
+ *      ...
+ *    }
+ *  ...
+ * }
+ * </pre>
+ * 
  * @subsection sec_requesting_measures Requesting measures
  * OFIQ implements a variety of measures for assessing properties of a facial
  * image. For a measure to be executed by OFIQ, it must be explicitly requested. 
@@ -652,6 +813,20 @@
  *   }
  * }
  * </pre>
+ * <br/>
+ * <br/>
+ * When only the quality mappings of a configuration change, stored results do not have to be
+ * re-assessed. The method \link OFIQ::Interface::rescoreScalars() rescoreScalars()\endlink
+ * recomputes the quality component values of a measure from a column of stored native quality
+ * scores in a single pass. The application <code>OFIQRescoreApp</code> applies it to the result file
+ * written by <code>OFIQSampleApp</code>:
+ * <pre>
+ * OFIQRescoreApp -c config/ofiq_config.jaxn -i results.csv -o rescored.csv
+ * </pre>
+ * Quality component values of measures that are not computed by a configurable quality mapping
+ * and results that were not assessed successfully are kept as stored. Note, the native quality
+ * scores of the result file are rounded to six decimal places such that the recomputed values may
+ * differ from a re-assessment for scores close to a rounding boundary.
  * 
  * @section sec_api C++ API
  * To use OFIQ in a C++ application one needs to include the following header file.
@@ -727,6 +902,91 @@
  * in the documentation of 
  * the \link OFIQ::FaceImageQualityPreprocessingResult FaceImageQualityPreprocessingResult\endlink struct.
  *
+ * A single initialized instance can compute different sets of measures per call. The overload of
+ * \link OFIQ_LIB::OFIQImpl::vectorQuality vectorQuality\endlink accepting a 
+ * \link OFIQ::QualityMeasureSelection QualityMeasureSelection\endlink computes only the selected measures
+ * among those requested in the configuration, e.g.,
+ * <pre>
+ * FaceImageQualityAssessment assessment;
+ * ReturnStatus retStatus = implPtr->vectorQuality(image, assessment,
+ *         QualityMeasureSelection{ QualityMeasure::UnifiedQualityScore, QualityMeasure::HeadPose });
+ * </pre>
+ * The preprocessing is restricted to the stages the selected measures need; in particular, the face parsing and
+ * face occlusion segmentation networks are not run if none of the selected measures depends on them.
+ *
+ * Callers that already run a face detector, a 98-point landmarker or a head pose estimator can pass their results
+ * in a \link OFIQ::FaceImageQualityPreprocessingInput FaceImageQualityPreprocessingInput\endlink object to
+ * \link OFIQ_LIB::OFIQImpl::vectorQualityWithPreprocessingInput vectorQualityWithPreprocessingInput\endlink;
+ * the corresponding networks are then skipped, e.g.,
+ * <pre>
+ * FaceImageQualityPreprocessingInput preprocessingInput;
+ * preprocessingInput.m_faces = { faceBoundingBox };
+ * preprocessingInput.m_landmarks = faceLandmarks; // of type LandmarkType::LM_98
+ * FaceImageQualityAssessment assessment;
+ * ReturnStatus retStatus = implPtr->vectorQualityWithPreprocessingInput(image, assessment, preprocessingInput);
+ * </pre>
+ * Supplied face boxes need not be square; like the boxes of the built-in detector, they are extended to a square
+ * before the landmarks are extracted from them.
+ * Since the quality scores depend on the pre-processing results, scores computed from results of other 
+ * detectors or landmarkers are not covered by the conformance tests.
+ *
+ * Servers and capture applications that keep several images in flight can use the
+ * \link OFIQ::AsyncInterface AsyncInterface\endlink declared in <code>ofiq_async.h</code>. It owns a pool of
+ * worker threads, each with its own initialized implementation, and a bounded queue of submitted images:
+ * <pre>
+ * AsyncInterface asyncImpl(4, 16); // 4 workers, at most 16 queued images
+ * ReturnStatus retStatus = asyncImpl.initialize(configDir, configFile);
+ * std::future<AsyncAssessmentResult> result = asyncImpl.submit(image);
+ * asyncImpl.submit(otherImage, [](AsyncAssessmentResult&& r) { ... });
+ * </pre>
+ * Since each worker loads the models, memory consumption grows with the number of workers. 
+ * The <code>submit</code> functions block while the queue is full.
+ *
+ * Interactive capture applications can receive intermediate results while an image is assessed by calling
+ * \link OFIQ_LIB::OFIQImpl::vectorQualityWithProgress vectorQualityWithProgress\endlink with an
+ * \link OFIQ::AssessmentProgress AssessmentProgress\endlink object. Its callbacks are invoked after each
+ * pre-processing stage (e.g. once the landmarks are available) and after each measure; returning false
+ * cancels the rest of the assessment. The pre-processing callback receives the reported artifact, i.e., the detected
+ * faces, the landmarks or a mask, in the representation of
+ * \link OFIQ_LIB::OFIQImpl::getPreprocessingResults getPreprocessingResults\endlink, e.g., 
+ * <pre>
+ * AssessmentProgress progress;
+ * progress.onPreprocessingResult = [](PreprocessingResultType type, const FaceImageQualityPreprocessingResult& result)
+ * {
+ *     // stop if no face has been detected; the faces are in coordinates of the original image
+ *     return type != PreprocessingResultType::Faces || !result.m_faces.empty();
+ * };
+ * progress.onMeasureResult = [](QualityMeasure measure, const QualityMeasureResult& result)
+ * {
+ *     // stop as soon as the head pose is known to be too far off
+ *     return measure != QualityMeasure::HeadPoseYaw || result.scalar >= 50;
+ * };
+ * FaceImageQualityAssessment assessment;
+ * ReturnStatus retStatus = implPtr->vectorQualityWithProgress(image, assessment, progress);
+ * </pre>
+ * A cancelled assessment returns \link OFIQ::ReturnCode::Cancelled ReturnCode::Cancelled\endlink; the results
+ * computed so far are kept and the remaining measures are set to
+ * \link OFIQ::QualityMeasureReturnCode::Skipped QualityMeasureReturnCode::Skipped\endlink.
+ *
+ * Servers can abort assessments whose clients have gone away or whose results would arrive too late by calling
+ * \link OFIQ_LIB::OFIQImpl::vectorQualityWithCancellation vectorQualityWithCancellation\endlink with an
+ * \link OFIQ::AssessmentCancellation AssessmentCancellation\endlink object holding a
+ * \link OFIQ::CancellationToken CancellationToken\endlink and/or a deadline, e.g., 
+ * <pre>
+ * AssessmentCancellation cancellation;
+ * cancellation.token = std::make_shared<CancellationToken>(); // cancel() may be called from any thread
+ * cancellation.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+ * ReturnStatus retStatus = implPtr->vectorQualityWithCancellation(image, assessment, cancellation);
+ * </pre>
+ * The token and the deadline are checked before each pre-processing stage and each measure, and running
+ * ONNX Runtime inferences are terminated via <code>Ort::RunOptions::SetTerminate</code>. The SSD face detector
+ * runs on OpenCV and completes before the check. An aborted assessment returns
+ * \link OFIQ::ReturnCode::Cancelled ReturnCode::Cancelled\endlink or
+ * \link OFIQ::ReturnCode::DeadlineExceeded ReturnCode::DeadlineExceeded\endlink with the remaining measures set to
+ * \link OFIQ::QualityMeasureReturnCode::Skipped QualityMeasureReturnCode::Skipped\endlink. The 
+ * \link OFIQ::AsyncInterface AsyncInterface\endlink accepts the same object, such that queued images whose
+ * deadline has passed are dropped without running any network.
+ *
  * @section sec_workflow Implementation and pre-processing workflow
  * Quality assessment is controlled by the implementation of 
  * the \link OFIQ_LIB::OFIQImpl OFIQImpl\endlink class. A shared pointer to an
@@ -213,6 +213,8 @@ class OfiqQualityMeasureReturnCode(IntEnum):
   """Unable to assess a quality measure"""
   NOT_INITIALIZED = 2
   """Quality measure is not initialized"""
+  SKIPPED = 3
+  """Quality measure was not computed since the image failed a gate of the assessment cascade"""
 
 
 class OfiqQualityMeasureResult(NamedTuple):
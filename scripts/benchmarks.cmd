@@ -0,0 +1,12 @@
+@echo off
+set config=Release
+IF "%1" == "--debug" (
+    set config=Debug
+)
+
+pushd %cd%
+
+cd ../build/build_win/Testing
+call "%config%/OFIQ_benchmarks.exe" --benchmark_out="../reports/benchmarks.json" --benchmark_out_format=json
+
+popd
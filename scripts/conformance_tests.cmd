@@ -2,11 +2,19 @@
 set config=Release
 IF "%1" == "--debug" (
     set config=Debug
+    shift
 )
+set args=
+:collect_args
+IF "%1" == "" GOTO args_done
+set args=%args% %1
+shift
+GOTO collect_args
+:args_done
 
 pushd %cd%
 
 cd ../build/build_win/Testing
-call "%config%/test_conformance_table.exe" --gtest_output=xml:"../reports/%%t.xml"
+call "%config%/test_conformance_table.exe" --gtest_output=xml:"../reports/%%t.xml" %args%
 
 popd
\ No newline at end of file
@@ -11,8 +11,9 @@ if [ "$1" = "--os" ]; then
         echo "$1" is a not a supported OS
         exit
     fi
+    shift
 fi
 
 cd ../${build_dir}/testing
-./test_conformance_table --gtest_output=xml:"../reports/$t.xml"
+./test_conformance_table --gtest_output=xml:"../reports/$t.xml" "$@"
 
@@ -0,0 +1,513 @@
+/**
+ * @file benchmark_ofiq.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+
+#include "AllDetectors.h"
+#include "AllLandmarks.h"
+#include "AllPoseEstimators.h"
+#include "Configuration.h"
+#include "FaceMeasures.h"
+#include "FaceOcclusionSegmentation.h"
+#include "FaceParsing.h"
+#include "GeometryPlan.h"
+#include "MeasureFactory.h"
+#include "OFIQError.h"
+#include "Session.h"
+#include "image_io.h"
+#include "image_utils.h"
+#include "ofiq_async.h"
+#include "utils.h"
+
+#include <benchmark/benchmark.h>
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using namespace OFIQ_LIB;
+using namespace OFIQ_LIB::modules::detectors;
+using namespace OFIQ_LIB::modules::landmarks;
+using namespace OFIQ_LIB::modules::measures;
+using namespace OFIQ_LIB::modules::poseEstimators;
+using namespace OFIQ_LIB::modules::segmentations;
+
+// paths relative to the working directory build/build_<os>/testing, as for the conformance tests;
+// can be changed by the arguments --ofiq_config_dir, --ofiq_config_file and --ofiq_images_dir
+static std::string OFIQ_LIB_CONFIG_DIR{ "../../../data" };
+static std::string OFIQ_LIB_CONFIG_FILE{ "ofiq_config.jaxn" };
+static std::string OFIQ_BENCHMARK_IMAGES_DIR{ "../../../data/tests/images" };
+
+// input resolutions in percent of the size of the test images
+static const std::vector<int64_t> imageScales{ 50, 100, 200 };
+
+// number of workers of the end-to-end throughput benchmark
+static const std::vector<int64_t> workerCounts{ 1, 2, 4, 8 };
+
+/**
+ * @brief Test image scaled to one of the benchmarked resolutions and pre-processed once.
+ * @details The session refers to the image and the assessment, such that the object must not be moved.
+ */
+struct PreparedImage
+{
+	OFIQ::Image image;
+	OFIQ::FaceImageQualityAssessment assessment;
+	std::unique_ptr<Session> session;
+};
+
+/**
+ * @brief Networks, measures and test images shared by all benchmarks.
+ * @details Everything is created on first use, such that loading the models is not measured.
+ * The networks and measures keep state between calls and are only used by single-threaded
+ * benchmarks.
+ */
+class BenchmarkEnvironment
+{
+public:
+	static BenchmarkEnvironment& Get()
+	{
+		static BenchmarkEnvironment environment;
+		return environment;
+	}
+
+	AlignmentMethod GetAlignmentMethod() const { return m_alignmentMethod; }
+
+	FaceDetectorInterface& GetFaceDetector() { return *m_faceDetector; }
+
+	FaceLandmarkExtractorInterface& GetLandmarkExtractor() { return *m_landmarkExtractor; }
+
+	PoseEstimatorInterface& GetPoseEstimator() { return *m_poseEstimator; }
+
+	SegmentationExtractorInterface& GetFaceParsing() { return *m_faceParsing; }
+
+	SegmentationExtractorInterface& GetFaceOcclusionSegmentation() { return *m_faceOcclusionSegmentation; }
+
+	const std::vector<std::unique_ptr<Measure>>& GetMeasures() const { return m_measures; }
+
+	/**
+	 * @brief Returns the test images at the given scale for which the pre-processing succeeded.
+	 */
+	const std::vector<std::unique_ptr<PreparedImage>>& GetPrepared(int64_t scale)
+	{
+		std::scoped_lock lock(m_preparedMutex);
+		auto it = m_prepared.find(scale);
+		if (it == m_prepared.end())
+			it = m_prepared.emplace(scale, Prepare(scale)).first;
+		return it->second;
+	}
+
+private:
+	/**
+	 * @brief Runs the pre-processing of OFIQImpl::preprocess() stage by stage.
+	 */
+	void Preprocess(Session& session)
+	{
+		auto faces = m_faceDetector->detectFaces(session);
+		if (faces.empty())
+			throw OFIQError(OFIQ::ReturnCode::FaceDetectionError, "No faces were detected");
+		session.setDetectedFaces(faces);
+		session.setPose(m_poseEstimator->estimatePose(session));
+		session.setLandmarks(m_landmarkExtractor->extractLandmarks(session));
+
+		OFIQ::FaceLandmarks alignedFaceLandmarks;
+		alignedFaceLandmarks.type = session.getLandmarks().type;
+		cv::Mat transformationMatrix;
+		session.setAlignedFace(alignImage(
+			session.getImageBGR(), session.getLandmarks(), alignedFaceLandmarks, transformationMatrix, m_alignmentMethod));
+		session.setAlignedFaceLandmarks(alignedFaceLandmarks);
+		session.setAlignedFaceTransformationMatrix(transformationMatrix);
+
+		double alpha = 0.0;
+		m_configuration->GetNumber("params.measures.FaceRegion.alpha", alpha);
+		const cv::Size alignedSize = session.getAlignedFace().size();
+		session.setAlignedFaceLandmarkedRegion(FaceMeasures::GetCachedFaceMask(
+			session, session.getAlignedFaceLandmarks(), alignedSize.height, alignedSize.width, (float)alpha));
+
+		session.setFaceParsingImage(copyToCvImage(m_faceParsing->GetMask(session, SegmentClassLabels::face), true));
+		session.setFaceParsingClassCounts(m_faceParsing->GetClassCounts());
+		session.setFaceOcclusionSegmentationImage(
+			copyToCvImage(m_faceOcclusionSegmentation->GetMask(session, SegmentClassLabels::face), true));
+	}
+
+	BenchmarkEnvironment()
+	{
+		m_configuration = std::make_unique<Configuration>(OFIQ_LIB_CONFIG_DIR, OFIQ_LIB_CONFIG_FILE);
+		m_alignmentMethod = GeometryPlan::GetAlignmentMethod(*m_configuration);
+		m_faceDetector = std::make_unique<SSDFaceDetector>(*m_configuration);
+		m_landmarkExtractor = std::make_unique<ADNetFaceLandmarkExtractor>(*m_configuration);
+		m_poseEstimator = std::make_unique<HeadPose3DDFAV2>(*m_configuration);
+		m_faceParsing = std::make_unique<FaceParsing>(*m_configuration);
+		m_faceOcclusionSegmentation = std::make_unique<FaceOcclusionSegmentation>(*m_configuration);
+
+		std::vector<std::string> measureNames;
+		m_configuration->GetStringList("measures", measureNames);
+		std::vector<OFIQ::QualityMeasure> measures;
+		for (const auto& name : measureNames)
+		{
+			if (auto measure = MeasureFromName(name); measure != OFIQ::QualityMeasure::NotSet)
+				measures.push_back(measure);
+		}
+		m_measures = MeasureFactory::CreateMeasures(measures, *m_configuration);
+
+		std::vector<fs::path> imageFiles;
+		for (const auto& entry : fs::directory_iterator(OFIQ_BENCHMARK_IMAGES_DIR))
+		{
+			std::string extension = entry.path().extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(),
+				[](unsigned char c) { return std::tolower(c); });
+			if (extension == ".jpg" || extension == ".jpeg" || extension == ".png")
+				imageFiles.push_back(entry.path());
+		}
+		// same order on all platforms
+		std::sort(imageFiles.begin(), imageFiles.end());
+		for (const auto& imageFile : imageFiles)
+		{
+			OFIQ::Image image;
+			if (readImage(imageFile.string(), image).code == OFIQ::ReturnCode::Success)
+				m_images.push_back(image);
+		}
+	}
+
+	std::vector<std::unique_ptr<PreparedImage>> Prepare(int64_t scale)
+	{
+		std::vector<std::unique_ptr<PreparedImage>> prepared;
+		for (const auto& image : m_images)
+		{
+			auto item = std::make_unique<PreparedImage>();
+			item->image = ScaleImage(image, scale);
+			item->session = std::make_unique<Session>(item->image, item->assessment);
+			try
+			{
+				Preprocess(*item->session);
+			}
+			catch (const std::exception&)
+			{
+				// e.g. no face detected at a low resolution
+				continue;
+			}
+			prepared.push_back(std::move(item));
+		}
+		return prepared;
+	}
+
+	static OFIQ::Image ScaleImage(const OFIQ::Image& image, int64_t scale)
+	{
+		if (scale == 100)
+			return image;
+
+		cv::Mat scaled;
+		cv::resize(copyToCvImage(image), scaled, cv::Size(), scale / 100.0, scale / 100.0,
+			scale < 100 ? cv::INTER_AREA : cv::INTER_LINEAR);
+		cv::cvtColor(scaled, scaled, cv::COLOR_BGR2RGB);
+
+		std::shared_ptr<uint8_t[]> data(new uint8_t[scaled.total() * 3]);
+		std::memcpy(data.get(), scaled.data, scaled.total() * 3);
+		return { static_cast<uint16_t>(scaled.cols), static_cast<uint16_t>(scaled.rows), 24, data };
+	}
+
+	std::unique_ptr<Configuration> m_configuration;
+	AlignmentMethod m_alignmentMethod = AlignmentMethod::LMEDS;
+	std::unique_ptr<FaceDetectorInterface> m_faceDetector;
+	std::unique_ptr<FaceLandmarkExtractorInterface> m_landmarkExtractor;
+	std::unique_ptr<PoseEstimatorInterface> m_poseEstimator;
+	std::unique_ptr<SegmentationExtractorInterface> m_faceParsing;
+	std::unique_ptr<SegmentationExtractorInterface> m_faceOcclusionSegmentation;
+	std::vector<std::unique_ptr<Measure>> m_measures;
+	std::vector<OFIQ::Image> m_images;
+	std::map<int64_t, std::vector<std::unique_ptr<PreparedImage>>> m_prepared;
+	std::mutex m_preparedMutex;
+};
+
+/**
+ * @brief Runs <code>function</code> on all prepared images of the benchmarked scale per iteration.
+ */
+template<class Function>
+void RunOverPreparedImages(benchmark::State& state, Function function)
+{
+	const auto& prepared = BenchmarkEnvironment::Get().GetPrepared(state.range(0));
+	if (prepared.empty())
+	{
+		state.SkipWithError("no test image could be pre-processed");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		for (const auto& item : prepared)
+			function(*item);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prepared.size()));
+	state.counters["images"] = benchmark::Counter(static_cast<double>(prepared.size()), benchmark::Counter::kAvgThreads);
+}
+
+// ############################
+// PRE-PROCESSING STAGES
+// ############################
+
+static void BM_DetectFaces(benchmark::State& state)
+{
+	auto& detector = BenchmarkEnvironment::Get().GetFaceDetector();
+	RunOverPreparedImages(state, [&detector](PreparedImage& item)
+		{
+			benchmark::DoNotOptimize(detector.detectFaces(*item.session));
+		});
+}
+BENCHMARK(BM_DetectFaces)->ArgName("scale")->ArgsProduct({ imageScales })->Unit(benchmark::kMillisecond);
+
+static void BM_EstimatePose(benchmark::State& state)
+{
+	auto& poseEstimator = BenchmarkEnvironment::Get().GetPoseEstimator();
+	RunOverPreparedImages(state, [&poseEstimator](PreparedImage& item)
+		{
+			benchmark::DoNotOptimize(poseEstimator.estimatePose(*item.session));
+		});
+}
+BENCHMARK(BM_EstimatePose)->ArgName("scale")->ArgsProduct({ imageScales })->Unit(benchmark::kMillisecond);
+
+static void BM_ExtractLandmarks(benchmark::State& state)
+{
+	auto& landmarkExtractor = BenchmarkEnvironment::Get().GetLandmarkExtractor();
+	RunOverPreparedImages(state, [&landmarkExtractor](PreparedImage& item)
+		{
+			benchmark::DoNotOptimize(landmarkExtractor.extractLandmarks(*item.session));
+		});
+}
+BENCHMARK(BM_ExtractLandmarks)->ArgName("scale")->ArgsProduct({ imageScales })->Unit(benchmark::kMillisecond);
+
+static void BM_AlignFaceImage(benchmark::State& state)
+{
+	const auto alignmentMethod = BenchmarkEnvironment::Get().GetAlignmentMethod();
+	RunOverPreparedImages(state, [alignmentMethod](PreparedImage& item)
+		{
+			OFIQ::FaceLandmarks alignedFaceLandmarks;
+			cv::Mat transformationMatrix;
+			benchmark::DoNotOptimize(alignImage(item.session->getImageBGR(), item.session->getLandmarks(),
+				alignedFaceLandmarks, transformationMatrix, alignmentMethod));
+		});
+}
+BENCHMARK(BM_AlignFaceImage)->ArgName("scale")->ArgsProduct({ imageScales })->Unit(benchmark::kMillisecond);
+
+static void BM_FaceParsing(benchmark::State& state)
+{
+	auto& faceParsing = BenchmarkEnvironment::Get().GetFaceParsing();
+	RunOverPreparedImages(state, [&faceParsing](PreparedImage& item)
+		{
+			benchmark::DoNotOptimize(faceParsing.GetMask(*item.session, SegmentClassLabels::face));
+		});
+}
+BENCHMARK(BM_FaceParsing)->ArgName("scale")->ArgsProduct({ imageScales })->Unit(benchmark::kMillisecond);
+
+static void BM_FaceOcclusionSegmentation(benchmark::State& state)
+{
+	auto& faceOcclusionSegmentation = BenchmarkEnvironment::Get().GetFaceOcclusionSegmentation();
+	RunOverPreparedImages(state, [&faceOcclusionSegmentation](PreparedImage& item)
+		{
+			benchmark::DoNotOptimize(faceOcclusionSegmentation.GetMask(*item.session, SegmentClassLabels::face));
+		});
+}
+BENCHMARK(BM_FaceOcclusionSegmentation)->ArgName("scale")->ArgsProduct({ imageScales })->Unit(benchmark::kMillisecond);
+
+// ############################
+// KERNELS
+// ############################
+
+static void BM_GetLuminanceImageFromBGR(benchmark::State& state)
+{
+	RunOverPreparedImages(state, [](PreparedImage& item)
+		{
+			benchmark::DoNotOptimize(GetLuminanceImageFromBGR(item.session->getImageBGR()));
+		});
+}
+BENCHMARK(BM_GetLuminanceImageFromBGR)->ArgName("scale")->ArgsProduct({ imageScales })
+	->ThreadRange(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_GetFaceMask(benchmark::State& state)
+{
+	RunOverPreparedImages(state, [](PreparedImage& item)
+		{
+			benchmark::DoNotOptimize(FaceMeasures::GetFaceMask(
+				item.session->getLandmarks(), item.image.height, item.image.width));
+		});
+}
+BENCHMARK(BM_GetFaceMask)->ArgName("scale")->ArgsProduct({ imageScales })
+	->ThreadRange(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_CalculateClassIds(benchmark::State& state)
+{
+	// scores of the face parsing CNN, whose output dimension does not depend on the input resolution
+	constexpr int nbChannels = 19;
+	constexpr int dimension = 400;
+	static const std::vector<float> scores = []
+		{
+			std::vector<float> values(static_cast<size_t>(nbChannels) * dimension * dimension);
+			std::mt19937 generator(42);
+			std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+			std::generate(values.begin(), values.end(), [&]() { return distribution(generator); });
+			return values;
+		}();
+
+	for (auto _ : state)
+	{
+		ClassCounts classCounts;
+		benchmark::DoNotOptimize(FaceParsing::CalculateClassIds(
+			scores.data(), nbChannels, dimension, dimension, classCounts));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateClassIds)->ThreadRange(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// ############################
+// END-TO-END THROUGHPUT
+// ############################
+
+static void BM_VectorQuality(benchmark::State& state)
+{
+	// only one instance is kept alive, as each worker holds its own networks; the
+	// worker count is the outer argument, such that it is initialized once per count
+	static std::unique_ptr<OFIQ::AsyncInterface> asyncInterface;
+	static int64_t asyncWorkers = 0;
+	if (asyncWorkers != state.range(0))
+	{
+		asyncInterface.reset();
+		asyncInterface = std::make_unique<OFIQ::AsyncInterface>(
+			static_cast<size_t>(state.range(0)), static_cast<size_t>(2 * state.range(0)));
+		asyncWorkers = state.range(0);
+		if (auto status = asyncInterface->initialize(OFIQ_LIB_CONFIG_DIR, OFIQ_LIB_CONFIG_FILE);
+			status.code != OFIQ::ReturnCode::Success)
+		{
+			asyncInterface.reset();
+			asyncWorkers = 0;
+			state.SkipWithError(status.info.c_str());
+			return;
+		}
+	}
+
+	std::vector<OFIQ::Image> images;
+	for (const auto& item : BenchmarkEnvironment::Get().GetPrepared(state.range(1)))
+		images.push_back(item->image);
+	if (images.empty())
+	{
+		state.SkipWithError("no test image could be pre-processed");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		std::vector<std::future<OFIQ::AsyncAssessmentResult>> results;
+		for (const auto& image : images)
+			results.push_back(asyncInterface->submit(image));
+		for (auto& result : results)
+		{
+			auto assessmentResult = result.get();
+			benchmark::DoNotOptimize(assessmentResult);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(images.size()));
+}
+BENCHMARK(BM_VectorQuality)->ArgNames({ "workers", "scale" })->ArgsProduct({ workerCounts, imageScales })
+	->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// ############################
+// MEASURES
+// ############################
+
+/**
+ * @brief Registers a benchmark of Measure::Execute() for each measure of the configuration.
+ * @details Caches of the session shared between measures (e.g., the luminance image) are filled
+ * by the first iteration, such that the benchmark reports the cost of the measure itself.
+ */
+static void RegisterMeasureBenchmarks()
+{
+	for (const auto& measure : BenchmarkEnvironment::Get().GetMeasures())
+	{
+		Measure* measurePtr = measure.get();
+		benchmark::RegisterBenchmark(("BM_Measure/" + measure->GetName()).c_str(),
+			[measurePtr](benchmark::State& state)
+			{
+				RunOverPreparedImages(state, [measurePtr](PreparedImage& item)
+					{
+						measurePtr->Execute(*item.session);
+					});
+			})
+			->ArgName("scale")->ArgsProduct({ imageScales })->Unit(benchmark::kMicrosecond);
+	}
+}
+
+/**
+ * @brief Consumes the arguments of this benchmark suite; all others are passed to Google Benchmark.
+ */
+static void ParseArguments(int& argc, char** argv)
+{
+	const std::vector<std::pair<std::string, std::string*>> options{
+		{ "--ofiq_config_dir=", &OFIQ_LIB_CONFIG_DIR },
+		{ "--ofiq_config_file=", &OFIQ_LIB_CONFIG_FILE },
+		{ "--ofiq_images_dir=", &OFIQ_BENCHMARK_IMAGES_DIR } };
+
+	int remaining = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument(argv[i]);
+		auto option = std::find_if(options.begin(), options.end(),
+			[&argument](const auto& candidate) { return argument.rfind(candidate.first, 0) == 0; });
+		if (option == options.end())
+			argv[remaining++] = argv[i];
+		else
+			*option->second = argument.substr(option->first.size());
+	}
+	argc = remaining;
+}
+
+int main(int argc, char** argv)
+{
+	ParseArguments(argc, argv);
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	try
+	{
+		RegisterMeasureBenchmarks();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Initializing the benchmarks failed: " << e.what() << std::endl;
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
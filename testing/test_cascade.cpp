@@ -0,0 +1,180 @@
+/**
+ * @file test_cascade.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "Configuration.h"
+#include "Executor.h"
+#include "OFIQError.h"
+#include "Session.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using namespace OFIQ;
+using namespace OFIQ_LIB;
+using namespace OFIQ_LIB::modules::measures;
+
+/**
+ * @brief Measure storing a fixed quality component value and counting its executions.
+ */
+class FixedMeasure : public Measure
+{
+public:
+	FixedMeasure(const Configuration& config, QualityMeasure measure, double scalar, int& executions)
+		: Measure(config, measure), m_scalar{scalar}, m_executions{executions}
+	{
+	}
+
+	void Execute(Session& session) override
+	{
+		m_executions++;
+		session.qualityResults().set(GetQualityMeasure(), { m_scalar, m_scalar, QualityMeasureReturnCode::Success });
+	}
+
+private:
+	double m_scalar;
+	int& m_executions;
+};
+
+/**
+ * @brief Provides a configuration and a session of a small image.
+ */
+class CascadeTest : public ::testing::Test
+{
+protected:
+	fs::path directory;
+	std::unique_ptr<Configuration> config;
+	FaceImageQualityAssessment assessment;
+	std::unique_ptr<Session> session;
+
+	void SetUp() override
+	{
+		directory = fs::temp_directory_path() /
+			("ofiq_cascade_test_" + std::to_string(std::random_device{}()));
+		fs::create_directories(directory);
+		std::ofstream(directory / "config.jaxn") << R"({ "config": { "params": {} } })";
+		config = std::make_unique<Configuration>(directory.string(), "config.jaxn");
+
+		Image image(4, 4, 24, std::shared_ptr<uint8_t[]>(new uint8_t[48]()));
+		session = std::make_unique<Session>(image, assessment);
+	}
+
+	void TearDown() override
+	{
+		session.reset();
+		config.reset();
+		std::error_code error;
+		fs::remove_all(directory, error);
+	}
+};
+
+TEST_F(CascadeTest, AllGatesPassed)
+{
+	int gateExecutions = 0;
+	int remainingExecutions = 0;
+	std::vector<std::unique_ptr<Measure>> measures;
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::DynamicRange, 10, remainingExecutions));
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::Sharpness, 80, gateExecutions));
+	Executor executor(std::move(measures));
+
+	executor.SetCascade({ { QualityMeasure::Sharpness, 50 } });
+	ASSERT_TRUE(executor.HasCascade());
+	EXPECT_EQ(executor.GetMeasures().front()->GetQualityMeasure(), QualityMeasure::Sharpness);
+
+	EXPECT_TRUE(executor.ExecuteGates(*session));
+	EXPECT_EQ(gateExecutions, 1);
+	EXPECT_EQ(remainingExecutions, 0);
+
+	executor.ExecuteRemaining(*session);
+	EXPECT_EQ(gateExecutions, 1);
+	EXPECT_EQ(remainingExecutions, 1);
+	EXPECT_EQ(session->qualityResults().find(QualityMeasure::DynamicRange)->code, QualityMeasureReturnCode::Success);
+}
+
+TEST_F(CascadeTest, FailedGateSkipsRemainingMeasures)
+{
+	int firstGateExecutions = 0;
+	int secondGateExecutions = 0;
+	int remainingExecutions = 0;
+	std::vector<std::unique_ptr<Measure>> measures;
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::DynamicRange, 90, remainingExecutions));
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::InterEyeDistance, 90, secondGateExecutions));
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::Sharpness, 20, firstGateExecutions));
+	Executor executor(std::move(measures));
+
+	executor.SetCascade({ { QualityMeasure::Sharpness, 50 }, { QualityMeasure::InterEyeDistance, 50 } });
+	EXPECT_FALSE(executor.ExecuteGates(*session));
+	EXPECT_EQ(firstGateExecutions, 1);
+	EXPECT_EQ(secondGateExecutions, 0);
+	EXPECT_EQ(remainingExecutions, 0);
+
+	executor.SetMissingResults(*session, QualityMeasureReturnCode::Skipped);
+	const auto& results = session->qualityResults();
+	EXPECT_EQ(results.find(QualityMeasure::Sharpness)->code, QualityMeasureReturnCode::Success);
+	EXPECT_EQ(results.find(QualityMeasure::Sharpness)->scalar, 20);
+	for (auto skipped : { QualityMeasure::InterEyeDistance, QualityMeasure::DynamicRange })
+	{
+		const auto* result = results.find(skipped);
+		ASSERT_NE(result, nullptr);
+		EXPECT_EQ(result->code, QualityMeasureReturnCode::Skipped);
+		EXPECT_EQ(result->scalar, -1);
+	}
+}
+
+TEST_F(CascadeTest, UnselectedGateIsNotChecked)
+{
+	int gateExecutions = 0;
+	int remainingExecutions = 0;
+	std::vector<std::unique_ptr<Measure>> measures;
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::DynamicRange, 90, remainingExecutions));
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::Sharpness, 20, gateExecutions));
+	Executor executor(std::move(measures));
+	executor.SetCascade({ { QualityMeasure::Sharpness, 50 } });
+
+	session->setMeasureSelection({ QualityMeasure::DynamicRange });
+	EXPECT_TRUE(executor.ExecuteGates(*session));
+	EXPECT_EQ(gateExecutions, 0);
+}
+
+TEST_F(CascadeTest, InvalidGatesAreRejected)
+{
+	int executions = 0;
+	std::vector<std::unique_ptr<Measure>> measures;
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::Sharpness, 20, executions));
+	measures.push_back(std::make_unique<FixedMeasure>(*config, QualityMeasure::BackgroundUniformity, 20, executions));
+	Executor executor(std::move(measures));
+
+	EXPECT_THROW(executor.SetCascade({ { QualityMeasure::InterEyeDistance, 50 } }), OFIQError);
+	EXPECT_THROW(executor.SetCascade({ { QualityMeasure::BackgroundUniformity, 50 } }), OFIQError);
+	executor.SetCascade({});
+	EXPECT_FALSE(executor.HasCascade());
+}
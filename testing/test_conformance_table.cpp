@@ -37,6 +37,8 @@
 #include <iostream>
 #include <magic_enum.hpp>
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
 
 namespace fs = std::filesystem;
 
@@ -62,6 +64,7 @@ using namespace OFIQ;
 static std::string OFIQ_LIB_CONFIG_DIR{ "../../../data" };
 static std::string OFIQ_LIB_CONFIG_FILE{ "ofiq_config.jaxn" };
 static std::string CONFORMANCE_TABLE_CSV{ "../../../data/tests/expected_results/expected_results.csv" };
+static std::string DRIFT_REPORT_CSV;
 
 static std::shared_ptr<OFIQ::Interface> ofiqImplInstance;
 static OFIQ::ReturnStatus ofiqInitResult;
@@ -105,6 +108,10 @@ std::vector<FaceImageAssessments> parseConformanceTableCSV(
 std::vector<std::tuple<std::string, OFIQ::QualityMeasure, double, double>> splitToSingleResults(
 	const std::vector<FaceImageAssessments>& imageAssessments);
 
+bool writeDriftReport(
+	const std::string& driftReportCSV,
+	const std::vector<FaceImageAssessments>& expectedAssessments);
+
 static std::vector<FaceImageAssessments> imageAssessments = loadConformanceTable(CONFORMANCE_TABLE_CSV);
 
 std::shared_ptr<OFIQ::Interface> getOfiqImplInstance(
@@ -254,6 +261,72 @@ INSTANTIATE_TEST_SUITE_P(
 	generateTestname
 );
 
+//
+// Drift report: per-measure deviation of the computed results from the
+// conformance table. Used to quantify the effect of opt-in configuration
+// switches (e.g. params.geometry.direct_warp or params.geometry.alignment)
+// by running this executable with -cf <alternative config> -d <report.csv>.
+//
+
+bool writeDriftReport(
+	const std::string& driftReportCSV,
+	const std::vector<FaceImageAssessments>& expectedAssessments)
+{
+	struct Drift
+	{
+		size_t count = 0;
+		size_t scalarMismatches = 0;
+		double maxRaw = 0;
+		double sumRaw = 0;
+		double maxScalar = 0;
+		double sumScalar = 0;
+	};
+	std::map<OFIQ::QualityMeasure, Drift> drifts;
+
+	for (const auto& expected : expectedAssessments)
+	{
+		auto cacheIter = assessmentsCache.find(fs::path(expected.imageFile).filename().string());
+		if (cacheIter == assessmentsCache.end())
+			continue;
+
+		for (const auto& [measure, expectedResult] : expected.qAssessments)
+		{
+			auto iter = cacheIter->second.qAssessments.find(measure);
+			if (iter == cacheIter->second.qAssessments.end())
+				continue;
+
+			double rawDiff = std::abs(iter->second.rawScore - expectedResult.rawScore);
+			double scalarDiff = std::abs(iter->second.scalar - expectedResult.scalar);
+			Drift& drift = drifts[measure];
+			drift.count++;
+			drift.maxRaw = std::max(drift.maxRaw, rawDiff);
+			drift.sumRaw += rawDiff;
+			drift.maxScalar = std::max(drift.maxScalar, scalarDiff);
+			drift.sumScalar += scalarDiff;
+			if (scalarDiff > 0)
+				drift.scalarMismatches++;
+		}
+	}
+
+	std::ofstream ofs(driftReportCSV);
+	if (!ofs.good())
+		return false;
+
+	ofs << "Measure;Images;MaxRawDiff;MeanRawDiff;MaxScalarDiff;MeanScalarDiff;ScalarMismatches" << std::endl;
+	for (const auto& [measure, drift] : drifts)
+	{
+		ofs << magic_enum::enum_name(measure) << ";"
+			<< drift.count << ";"
+			<< drift.maxRaw << ";"
+			<< drift.sumRaw / static_cast<double>(drift.count) << ";"
+			<< drift.maxScalar << ";"
+			<< drift.sumScalar / static_cast<double>(drift.count) << ";"
+			<< drift.scalarMismatches << std::endl;
+	}
+	printf("Drift report written to: %s\n", driftReportCSV.c_str());
+	return true;
+}
+
 //
 // Helper functions for parsing conformance table
 //
@@ -407,9 +480,19 @@ int main(int argc, char* args[])
 			OFIQ_LIB_CONFIG_FILE = args[++i];
 		else if (strcmp(args[i], "-r") == 0 && i + 1 < argc)
 			CONFORMANCE_TABLE_CSV = args[++i];
+		else if (strcmp(args[i], "-d") == 0 && i + 1 < argc)
+			DRIFT_REPORT_CSV = args[++i];
 	}
 
 	imageAssessments = loadConformanceTable(CONFORMANCE_TABLE_CSV);
 
-	return RUN_ALL_TESTS();
+	int result = RUN_ALL_TESTS();
+
+	if (!DRIFT_REPORT_CSV.empty() && !writeDriftReport(DRIFT_REPORT_CSV, imageAssessments))
+	{
+		printf("Can't write drift report: %s\n", DRIFT_REPORT_CSV.c_str());
+		return 1;
+	}
+
+	return result;
 }
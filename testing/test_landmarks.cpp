@@ -0,0 +1,199 @@
+/**
+ * @file test_landmarks.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "adnet_landmarks.h"
+#include "FaceMeasures.h"
+#include "Session.h"
+
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace OFIQ;
+using OFIQ_LIB::RoiMask;
+using OFIQ_LIB::Session;
+using OFIQ_LIB::modules::landmarks::ADNetFaceLandmarkExtractor;
+using OFIQ_LIB::modules::landmarks::FaceMeasures;
+
+/**
+ * @brief Creates 98 landmarks on a face-like oval.
+ */
+static FaceLandmarks MakeOvalLandmarks(int centerX, int centerY, int radiusX, int radiusY)
+{
+	FaceLandmarks landmarks;
+	landmarks.type = LandmarkType::LM_98;
+	for (int i = 0; i < 98; i++)
+	{
+		const double angle = 2 * 3.14159265358979 * i / 98;
+		// every other point lies inside so that the hull does not contain all landmarks
+		const double scale = i % 2 == 0 ? 1.0 : 0.6;
+		landmarks.landmarks.emplace_back(
+			static_cast<int16_t>(centerX + std::lround(scale * radiusX * std::cos(angle))),
+			static_cast<int16_t>(centerY + std::lround(scale * radiusY * std::sin(angle))));
+	}
+	return landmarks;
+}
+
+/**
+ * @brief Face mask as computed by the baseline: the convex hull drawn at 224x224 pixels,
+ * nearest-upscaled and copied into a zero image.
+ */
+static cv::Mat BaselineFaceMask(const FaceLandmarks& faceLandmarks, int height, int width)
+{
+	std::vector<cv::Point2i> landmarkPoints;
+	for (const auto& landmark : faceLandmarks.landmarks)
+		landmarkPoints.emplace_back(landmark.x, landmark.y);
+	std::vector<cv::Point2i> hullPoints;
+	cv::convexHull(landmarkPoints, hullPoints);
+	cv::Rect rect = cv::boundingRect(hullPoints);
+	auto b = (int)(rect.y - rect.height * 0.05);
+	auto d = (int)(rect.y + rect.height * 1.05);
+	auto a = (int)(rect.x + rect.width / 2.0 - (d - b) / 2.0);
+	auto c = (int)(rect.x + rect.width / 2.0 + (d - b) / 2.0);
+	int imgSize = 224;
+	for (auto& p : hullPoints)
+	{
+		cv::Point2f cropped = p;
+		cropped = (cropped - cv::Point2f(static_cast<float>(a), static_cast<float>(b))) / static_cast<float>(d - b) * static_cast<float>(imgSize);
+		p.x = static_cast<int>(cropped.x);
+		p.y = static_cast<int>(cropped.y);
+	}
+	cv::Mat mask = cv::Mat::zeros(cv::Size(imgSize, imgSize), CV_8UC1);
+	cv::fillConvexPoly(mask, hullPoints, cv::Scalar(1));
+	cv::Mat faceRegion = cv::Mat::zeros(cv::Size(width, height), CV_8UC1);
+	cv::Mat maskRescaled;
+	cv::resize(mask, maskRescaled, cv::Size(c - a, d - b), 0, 0, cv::INTER_NEAREST);
+	int left = 0;
+	int top = 0;
+	int right = maskRescaled.cols;
+	int bottom = maskRescaled.rows;
+	int an = a;
+	int bn = b;
+	int cn = c;
+	int dn = d;
+	if (a < 0)
+	{
+		left -= a;
+		an = 0;
+	}
+	if (c > width)
+	{
+		right = maskRescaled.cols - (c - width);
+		cn = width;
+	}
+	if (b < 0)
+	{
+		top -= b;
+		bn = 0;
+	}
+	if (d > height)
+	{
+		bottom = maskRescaled.rows - (d - height);
+		dn = height;
+	}
+	cv::Mat crop = maskRescaled(cv::Range(top, bottom), cv::Range(left, right));
+	crop.copyTo(faceRegion(cv::Range(bn, dn), cv::Range(an, cn)));
+	return faceRegion;
+}
+
+TEST(FaceMask, MatchesBaselineRaster)
+{
+	const int width = 240;
+	const int height = 200;
+	// inside the image, reaching over the top left corner and reaching over the bottom right corner
+	for (const auto& landmarks : {
+		MakeOvalLandmarks(120, 100, 50, 70),
+		MakeOvalLandmarks(20, 15, 45, 60),
+		MakeOvalLandmarks(215, 170, 60, 80) })
+	{
+		const cv::Mat expected = BaselineFaceMask(landmarks, height, width);
+		const RoiMask mask = FaceMeasures::GetFaceMaskRoi(landmarks, height, width);
+		EXPECT_EQ(mask.imageSize(), cv::Size(width, height));
+		EXPECT_EQ(cv::countNonZero(mask.toMat() != expected), 0);
+		EXPECT_EQ(mask.countNonZero(), cv::countNonZero(expected));
+		EXPECT_EQ(cv::countNonZero(FaceMeasures::GetFaceMask(landmarks, height, width) != expected), 0);
+	}
+}
+
+TEST(FaceMask, ComputedOncePerSession)
+{
+	Image image(4, 4, 24, std::shared_ptr<uint8_t[]>(new uint8_t[48]()));
+	FaceImageQualityAssessment assessment;
+	Session session(image, assessment);
+	const FaceLandmarks landmarks = MakeOvalLandmarks(120, 100, 50, 70);
+
+	const RoiMask first = FaceMeasures::GetCachedFaceMask(session, landmarks, 200, 240);
+	const RoiMask second = FaceMeasures::GetCachedFaceMask(session, landmarks, 200, 240);
+	EXPECT_EQ(first.data().data, second.data().data) << "the cached mask is shared";
+
+	const RoiMask otherSize = FaceMeasures::GetCachedFaceMask(session, landmarks, 200, 200);
+	EXPECT_NE(first.data().data, otherSize.data().data);
+	EXPECT_EQ(otherSize.imageSize(), cv::Size(200, 200));
+}
+
+TEST(ADNetCropBox, SuppliedBoxesAreSquared)
+{
+	// boxes supplied by the caller carry no detector type
+	const BoundingBox supplied(100, 20, 100, 200, FaceDetectorType::NotSet);
+	const BoundingBox cropBox = ADNetFaceLandmarkExtractor::GetCropBox(supplied);
+
+	EXPECT_EQ(cropBox.width, cropBox.height);
+	EXPECT_EQ(cropBox.xleft, 50);
+	EXPECT_EQ(cropBox.ytop, 20);
+	EXPECT_EQ(cropBox.height, 200);
+}
+
+TEST(ADNetCropBox, SquareBoxesAreKept)
+{
+	const BoundingBox detected(10, 30, 120, 120, FaceDetectorType::OPENCVSSD);
+	const BoundingBox cropBox = ADNetFaceLandmarkExtractor::GetCropBox(detected);
+
+	EXPECT_EQ(cropBox.xleft, detected.xleft);
+	EXPECT_EQ(cropBox.ytop, detected.ytop);
+	EXPECT_EQ(cropBox.width, detected.width);
+	EXPECT_EQ(cropBox.height, detected.height);
+}
+
+TEST(ADNetCropBox, LandmarksOfNonSquareBoxMapToImage)
+{
+	const BoundingBox supplied(100, 20, 100, 200, FaceDetectorType::NotSet);
+	const std::vector<float> netLandmarks{ 0.0f, 0.0f, 128.0f, 128.0f, 256.0f, 256.0f };
+
+	const FaceLandmarks landmarks = ADNetFaceLandmarkExtractor::MapToImage(
+		netLandmarks, ADNetFaceLandmarkExtractor::GetCropBox(supplied));
+
+	ASSERT_EQ(landmarks.landmarks.size(), 3u);
+	EXPECT_EQ(landmarks.type, LandmarkType::LM_98);
+	// the centre of the network input is the centre of the supplied box in both directions
+	EXPECT_EQ(landmarks.landmarks[1].x, supplied.xleft + supplied.width / 2);
+	EXPECT_EQ(landmarks.landmarks[1].y, supplied.ytop + supplied.height / 2);
+	EXPECT_EQ(landmarks.landmarks[0].x, 50);
+	EXPECT_EQ(landmarks.landmarks[0].y, 20);
+	EXPECT_EQ(landmarks.landmarks[2].x, 250);
+	EXPECT_EQ(landmarks.landmarks[2].y, 220);
+}
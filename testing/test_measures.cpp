@@ -0,0 +1,109 @@
+/**
+ * @file test_measures.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "Configuration.h"
+#include "Measure.h"
+#include "MeasureRegistry.h"
+#include "OFIQError.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+using namespace OFIQ;
+using namespace OFIQ_LIB;
+using namespace OFIQ_LIB::modules::measures;
+
+/**
+ * @brief Measure exposing the name-based quality mapping.
+ */
+class NamedMeasure : public Measure
+{
+public:
+	NamedMeasure(const Configuration& config, QualityMeasure measure)
+		: Measure(config, measure)
+	{
+	}
+
+	void Execute(Session&) override
+	{
+	}
+
+	using Measure::AddSigmoid;
+	using Measure::ExecuteScalarConversion;
+};
+
+/**
+ * @brief Reads a configuration without parameters.
+ */
+static std::unique_ptr<Configuration> MakeConfiguration()
+{
+	const fs::path directory = fs::temp_directory_path() /
+		("ofiq_measures_test_" + std::to_string(std::random_device{}()));
+	fs::create_directories(directory);
+	std::ofstream(directory / "config.jaxn") << R"({ "config": { "params": {} } })";
+	auto config = std::make_unique<Configuration>(directory.string(), "config.jaxn");
+	std::error_code error;
+	fs::remove_all(directory, error);
+	return config;
+}
+
+TEST(MeasureRegistry, NamesResolveToTheirMeasures)
+{
+	for (const auto& entry : measureRegistry)
+	{
+		EXPECT_EQ(MeasureFromName(entry.name), entry.measure) << entry.name;
+		EXPECT_EQ(MeasureName(entry.measure), entry.name);
+	}
+	EXPECT_EQ(MeasureFromName("Sharpnes"), QualityMeasure::NotSet);
+}
+
+TEST(Measure, Names)
+{
+	const auto config = MakeConfiguration();
+	EXPECT_EQ(NamedMeasure(*config, QualityMeasure::Sharpness).GetName(), "Sharpness");
+	EXPECT_EQ(NamedMeasure(*config, QualityMeasure::HeadPoseYaw).GetName(), "HeadPoseYaw");
+	EXPECT_EQ(NamedMeasure(*config, QualityMeasure::NotSet).GetName(), "NotSet");
+}
+
+TEST(Measure, UnknownNamesAreRejected)
+{
+	const auto config = MakeConfiguration();
+	NamedMeasure measure(*config, QualityMeasure::Sharpness);
+
+	EXPECT_THROW(measure.AddSigmoid("Sharpnes", SigmoidParameters()), OFIQError);
+	EXPECT_THROW(measure.ExecuteScalarConversion("Sharpnes", 4), OFIQError);
+	EXPECT_THROW(measure.AddSigmoid("NotSet", SigmoidParameters()), OFIQError);
+
+	measure.AddSigmoid("Sharpness", SigmoidParameters());
+	EXPECT_EQ(measure.ExecuteScalarConversion("Sharpness", 4), 50);
+	EXPECT_EQ(measure.ExecuteScalarConversion("Sharpness", 4), measure.ExecuteScalarConversion(QualityMeasure::Sharpness, 4));
+}
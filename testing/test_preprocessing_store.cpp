@@ -0,0 +1,232 @@
+/**
+ * @file test_preprocessing_store.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "Configuration.h"
+#include "PreprocessingStore.h"
+#include "Session.h"
+
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+using namespace OFIQ;
+using namespace OFIQ_LIB;
+
+/**
+ * @brief Creates a BGR image with a gradient pattern.
+ */
+static Image MakeImage(uint16_t width, uint16_t height, uint8_t offset)
+{
+	std::shared_ptr<uint8_t[]> data(new uint8_t[static_cast<size_t>(width) * height * 3]);
+	for (size_t i = 0; i < static_cast<size_t>(width) * height * 3; i++)
+		data[i] = static_cast<uint8_t>(i * 7 + offset);
+	return Image(width, height, 24, data);
+}
+
+/**
+ * @brief Creates landmarks with the given number of points.
+ */
+static FaceLandmarks MakeLandmarks(size_t count, int16_t offset)
+{
+	FaceLandmarks landmarks;
+	landmarks.type = LandmarkType::LM_98;
+	for (size_t i = 0; i < count; i++)
+	{
+		LandmarkPoint point;
+		point.x = static_cast<int16_t>(offset + i);
+		point.y = static_cast<int16_t>(offset + 2 * i);
+		landmarks.landmarks.push_back(point);
+	}
+	return landmarks;
+}
+
+/**
+ * @brief Provides an empty store directory and an image with pre-processing artifacts.
+ */
+class PreprocessingStoreTest : public ::testing::Test
+{
+protected:
+	fs::path directory;
+	Image image = MakeImage(64, 48, 0);
+	FaceImageQualityAssessment assessment;
+	std::unique_ptr<Session> session;
+
+	void SetUp() override
+	{
+		directory = fs::temp_directory_path() /
+			("ofiq_preprocessing_store_test_" + std::to_string(std::random_device{}()));
+
+		session = std::make_unique<Session>(image, assessment);
+		session->setDetectedFaces({
+			BoundingBox(4, 5, 30, 32, FaceDetectorType::OPENCVSSD),
+			BoundingBox(40, 2, 10, 12, FaceDetectorType::OPENCVSSD) });
+		session->setPose({ 1.5, -2.25, 10.0 });
+		session->setLandmarks(MakeLandmarks(98, 3));
+
+		cv::Mat transformationMatrix = (cv::Mat_<double>(2, 3) << 0.9, 0.1, -2.5, -0.1, 0.9, 3.25);
+		cv::Mat alignedFace;
+		cv::warpAffine(session->getImageBGR(), alignedFace, transformationMatrix, cv::Size(32, 40));
+		session->setAlignedFace(alignedFace);
+		session->setAlignedFaceTransformationMatrix(transformationMatrix);
+		session->setAlignedFaceLandmarks(MakeLandmarks(98, 1));
+	}
+
+	void TearDown() override
+	{
+		std::error_code error;
+		fs::remove_all(directory, error);
+	}
+
+	void SetSegmentations()
+	{
+		cv::Mat parsing(40, 32, CV_8UC1);
+		cv::randu(parsing, 0, 19);
+		cv::Mat occlusion = cv::Mat::zeros(40, 32, CV_8UC1);
+		occlusion(cv::Rect(5, 6, 10, 12)) = 1;
+		session->setFaceParsingImage(parsing);
+		session->setFaceOcclusionSegmentationImage(occlusion);
+	}
+};
+
+TEST_F(PreprocessingStoreTest, FaceGeometryRoundTrip)
+{
+	PreprocessingStore(PreprocessingStore::Mode::Write, directory.string()).Save(*session);
+
+	FaceImageQualityAssessment loadedAssessment;
+	Session loaded(image, loadedAssessment);
+	const auto artifacts =
+		PreprocessingStore(PreprocessingStore::Mode::Read, directory.string()).Load(loaded, true, true);
+	ASSERT_TRUE(artifacts.faceGeometry);
+	EXPECT_FALSE(artifacts.segmentations) << "segmentations have not been stored";
+
+	const auto faces = loaded.getDetectedFaces();
+	ASSERT_EQ(faces.size(), 2);
+	EXPECT_EQ(faces[1].xleft, 40);
+	EXPECT_EQ(faces[1].height, 12);
+	EXPECT_EQ(loadedAssessment.boundingBox.width, 30);
+	EXPECT_EQ(loaded.getPose(), session->getPose());
+
+	const auto landmarks = loaded.getLandmarks();
+	ASSERT_EQ(landmarks.landmarks.size(), 98);
+	EXPECT_EQ(landmarks.type, LandmarkType::LM_98);
+	EXPECT_EQ(landmarks.landmarks[97].y, session->getLandmarks().landmarks[97].y);
+	EXPECT_EQ(loaded.getAlignedFaceLandmarks().landmarks[10].x, session->getAlignedFaceLandmarks().landmarks[10].x);
+
+	EXPECT_EQ(cv::norm(loaded.getAlignedFaceTransformationMatrix(), session->getAlignedFaceTransformationMatrix()), 0);
+	EXPECT_EQ(cv::norm(loaded.getAlignedFace(), session->getAlignedFace(), cv::NORM_INF), 0)
+		<< "the aligned face is reproduced from the stored transformation";
+	EXPECT_TRUE(loaded.getAlignedFaceLandmarkedRegionRoi().empty())
+		<< "the landmarked region depends on measure parameters and is not stored";
+}
+
+TEST_F(PreprocessingStoreTest, SegmentationsRoundTrip)
+{
+	SetSegmentations();
+	PreprocessingStore(PreprocessingStore::Mode::Write, directory.string()).Save(*session);
+
+	FaceImageQualityAssessment loadedAssessment;
+	Session loaded(image, loadedAssessment);
+	const auto artifacts =
+		PreprocessingStore(PreprocessingStore::Mode::Read, directory.string()).Load(loaded, true, true);
+	ASSERT_TRUE(artifacts.faceGeometry);
+	ASSERT_TRUE(artifacts.segmentations);
+	EXPECT_EQ(cv::norm(loaded.faceParsingImage(), session->faceParsingImage(), cv::NORM_INF), 0);
+	EXPECT_EQ(cv::norm(loaded.faceOcclusionSegmentationImage(), session->faceOcclusionSegmentationImage(), cv::NORM_INF), 0);
+}
+
+TEST_F(PreprocessingStoreTest, OnlyRequestedArtifactsAreLoaded)
+{
+	SetSegmentations();
+	PreprocessingStore(PreprocessingStore::Mode::Write, directory.string()).Save(*session);
+
+	FaceImageQualityAssessment loadedAssessment;
+	Session loaded(image, loadedAssessment);
+	const auto artifacts =
+		PreprocessingStore(PreprocessingStore::Mode::Read, directory.string()).Load(loaded, false, true);
+	EXPECT_FALSE(artifacts.faceGeometry);
+	EXPECT_TRUE(artifacts.segmentations);
+	EXPECT_TRUE(loaded.getDetectedFaces().empty());
+}
+
+TEST_F(PreprocessingStoreTest, MissingAndCorruptFilesAreIgnored)
+{
+	PreprocessingStore(PreprocessingStore::Mode::Write, directory.string()).Save(*session);
+	const PreprocessingStore store(PreprocessingStore::Mode::Read, directory.string());
+
+	// another image has no stored artifacts
+	const Image otherImage = MakeImage(64, 48, 1);
+	FaceImageQualityAssessment otherAssessment;
+	Session other(otherImage, otherAssessment);
+	EXPECT_FALSE(store.Load(other, true, true).faceGeometry);
+
+	// truncated files are treated as missing
+	for (const auto& entry : fs::directory_iterator(directory))
+		fs::resize_file(entry.path(), fs::file_size(entry.path()) / 2);
+	FaceImageQualityAssessment loadedAssessment;
+	Session loaded(image, loadedAssessment);
+	const auto artifacts = store.Load(loaded, true, true);
+	EXPECT_FALSE(artifacts.faceGeometry);
+	EXPECT_FALSE(artifacts.segmentations);
+	EXPECT_TRUE(loaded.getDetectedFaces().empty());
+}
+
+TEST_F(PreprocessingStoreTest, OtherConfigurationIsAMiss)
+{
+	PreprocessingStore(PreprocessingStore::Mode::Write, directory.string(), 1).Save(*session);
+
+	FaceImageQualityAssessment otherAssessment;
+	Session other(image, otherAssessment);
+	EXPECT_FALSE(PreprocessingStore(PreprocessingStore::Mode::Read, directory.string(), 2).Load(other, true, true).faceGeometry);
+	EXPECT_TRUE(other.getDetectedFaces().empty());
+
+	FaceImageQualityAssessment loadedAssessment;
+	Session loaded(image, loadedAssessment);
+	EXPECT_TRUE(PreprocessingStore(PreprocessingStore::Mode::Read, directory.string(), 1).Load(loaded, true, true).faceGeometry);
+}
+
+TEST_F(PreprocessingStoreTest, ConfigurationHashIgnoresMeasureParameters)
+{
+	fs::create_directories(directory);
+	const auto hashOf = [this](const std::string& name, const std::string& alignment, double x0, bool fused)
+	{
+		std::ofstream(directory / name) <<
+			R"({ "config": { "params": { "geometry": { "alignment": ")" << alignment << R"(" }, )" <<
+			R"("measures": { "Sharpness": { "Sigmoid": { "x0": )" << x0 << R"( } }, )" <<
+			R"("FaceParsing": { "fused_preprocessing": )" << (fused ? "true" : "false") << " } } } } }";
+		return PreprocessingStore::ConfigurationHash(Configuration(directory.string(), name));
+	};
+
+	const uint64_t hash = hashOf("base.jaxn", "LMEDS", 1, false);
+	EXPECT_EQ(hash, hashOf("sigmoid.jaxn", "LMEDS", 2, false));
+	EXPECT_NE(hash, hashOf("alignment.jaxn", "Umeyama", 1, false));
+	EXPECT_NE(hash, hashOf("parsing.jaxn", "LMEDS", 1, true));
+}
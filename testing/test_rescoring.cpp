@@ -0,0 +1,152 @@
+/**
+ * @file test_rescoring.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "Configuration.h"
+#include "Executor.h"
+#include "OFIQError.h"
+#include "Session.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using namespace OFIQ;
+using namespace OFIQ_LIB;
+using namespace OFIQ_LIB::modules::measures;
+
+/**
+ * @brief Measure mapping a fixed native quality score by the configured sigmoid.
+ */
+class MappedMeasure : public Measure
+{
+public:
+	MappedMeasure(const Configuration& config, QualityMeasure measure, double rawScore)
+		: Measure(config, measure), m_rawScore{rawScore}
+	{
+		AddSigmoid(measure, SigmoidParameters());
+	}
+
+	void Execute(Session& session) override
+	{
+		SetQualityMeasure(session, GetQualityMeasure(), m_rawScore, QualityMeasureReturnCode::Success);
+	}
+
+private:
+	double m_rawScore;
+};
+
+/**
+ * @brief Measure storing its native quality score without a sigmoid.
+ */
+class UnmappedMeasure : public Measure
+{
+public:
+	UnmappedMeasure(const Configuration& config, QualityMeasure measure)
+		: Measure(config, measure)
+	{
+	}
+
+	void Execute(Session& session) override
+	{
+		session.qualityResults().set(GetQualityMeasure(), { 20, 20, QualityMeasureReturnCode::Success });
+	}
+};
+
+/**
+ * @brief Provides a configuration defining the sigmoid of Sharpness and a session of a small image.
+ */
+class RescoringTest : public ::testing::Test
+{
+protected:
+	fs::path directory;
+	std::unique_ptr<Configuration> config;
+	FaceImageQualityAssessment assessment;
+	std::unique_ptr<Session> session;
+
+	void SetUp() override
+	{
+		directory = fs::temp_directory_path() /
+			("ofiq_rescoring_test_" + std::to_string(std::random_device{}()));
+		fs::create_directories(directory);
+		std::ofstream(directory / "config.jaxn") <<
+			R"({ "config": { "params": { "measures": { "Sharpness": { "Sigmoid": { "x0": 0.5, "w": 0.1 } } } } } })";
+		config = std::make_unique<Configuration>(directory.string(), "config.jaxn");
+
+		Image image(4, 4, 24, std::shared_ptr<uint8_t[]>(new uint8_t[48]()));
+		session = std::make_unique<Session>(image, assessment);
+	}
+
+	void TearDown() override
+	{
+		session.reset();
+		config.reset();
+		std::error_code error;
+		fs::remove_all(directory, error);
+	}
+};
+
+TEST_F(RescoringTest, RescoreReproducesQualityMapping)
+{
+	const double rawScore = 0.62;
+	std::vector<std::unique_ptr<Measure>> measures;
+	measures.push_back(std::make_unique<MappedMeasure>(*config, QualityMeasure::Sharpness, rawScore));
+	Executor executor(std::move(measures));
+	executor.ExecuteAll(*session);
+	const double computed = session->qualityResults().find(QualityMeasure::Sharpness)->scalar;
+	EXPECT_EQ(computed, std::round(100 / (1 + std::exp((0.5 - rawScore) / 0.1))));
+
+	std::vector<double> rawScores = { rawScore, 0.5, 0.0, 0.9 };
+	std::vector<double> scalars = { 0, 0, -1, 0 };
+	ASSERT_TRUE(executor.RescoreScalars(QualityMeasure::Sharpness, rawScores, scalars));
+	EXPECT_EQ(scalars[0], computed);
+	EXPECT_EQ(scalars[1], 50);
+	EXPECT_EQ(scalars[2], -1) << "results not assessed successfully are left unchanged";
+	EXPECT_EQ(scalars[3], 98);
+}
+
+TEST_F(RescoringTest, RescoreRejectsUnmappedMeasures)
+{
+	std::vector<std::unique_ptr<Measure>> measures;
+	measures.push_back(std::make_unique<MappedMeasure>(*config, QualityMeasure::Sharpness, 0.5));
+	measures.push_back(std::make_unique<UnmappedMeasure>(*config, QualityMeasure::DynamicRange));
+	Executor executor(std::move(measures));
+
+	std::vector<double> rawScores = { 0.5 };
+	std::vector<double> scalars = { 7 };
+	EXPECT_FALSE(executor.RescoreScalars(QualityMeasure::DynamicRange, rawScores, scalars));
+	EXPECT_FALSE(executor.RescoreScalars(QualityMeasure::HeadSize, rawScores, scalars));
+	EXPECT_EQ(scalars[0], 7);
+
+	std::vector<double> tooFew;
+	EXPECT_THROW(executor.RescoreScalars(QualityMeasure::Sharpness, rawScores, tooFew), OFIQError);
+}
@@ -0,0 +1,171 @@
+/**
+ * @file test_result_cache.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "ResultCache.h"
+#include "utils.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using namespace OFIQ;
+using OFIQ_LIB::hashBytes;
+
+/**
+ * @brief Provides an empty directory for the persistent store of the result cache.
+ */
+class ResultCacheTest : public ::testing::Test
+{
+protected:
+	fs::path directory;
+
+	void SetUp() override
+	{
+		directory = fs::temp_directory_path() /
+			("ofiq_result_cache_test_" + std::to_string(std::random_device{}()));
+		fs::create_directories(directory);
+	}
+
+	void TearDown() override
+	{
+		std::error_code error;
+		fs::remove_all(directory, error);
+	}
+
+	/**
+	 * @brief Inserts an assessment into a cache of capacity 1 and evicts it again,
+	 * such that the lookup has to read it from the persistent store.
+	 */
+	bool RoundTrip(const FaceImageQualityAssessment& stored, FaceImageQualityAssessment& loaded) const
+	{
+		OFIQ_LIB::ResultCache cache(1, directory.string(), 0x1234);
+		OFIQ_LIB::ResultCache::Entry entry;
+		entry.assessment = stored;
+		cache.Insert(1, entry);
+		cache.Insert(2, OFIQ_LIB::ResultCache::Entry());
+
+		OFIQ_LIB::ResultCache::Entry found;
+		if (!cache.Find(1, 0, found, 0))
+			return false;
+		loaded = found.assessment;
+		return true;
+	}
+};
+
+TEST_F(ResultCacheTest, PersistedAssessmentRoundTrip)
+{
+	FaceImageQualityAssessment stored;
+	stored.boundingBox = BoundingBox(10, 20, 30, 40, FaceDetectorType::OPENCVSSD);
+	stored.qAssessments[QualityMeasure::Sharpness] =
+		QualityMeasureResult(0.1234567890123456789, 42, QualityMeasureReturnCode::Success);
+	stored.qAssessments[QualityMeasure::HeadPoseYaw] =
+		QualityMeasureResult(-3.5e-12, 100, QualityMeasureReturnCode::Success);
+
+	FaceImageQualityAssessment loaded;
+	ASSERT_TRUE(RoundTrip(stored, loaded));
+
+	EXPECT_EQ(loaded.boundingBox.xleft, 10);
+	EXPECT_EQ(loaded.boundingBox.ytop, 20);
+	EXPECT_EQ(loaded.boundingBox.width, 30);
+	EXPECT_EQ(loaded.boundingBox.height, 40);
+	EXPECT_EQ(loaded.boundingBox.faceDetector, FaceDetectorType::OPENCVSSD);
+	ASSERT_EQ(loaded.qAssessments.size(), stored.qAssessments.size());
+	for (const auto& [measure, result] : stored.qAssessments)
+	{
+		const auto& other = loaded.qAssessments.at(measure);
+		EXPECT_EQ(other.rawScore, result.rawScore);
+		EXPECT_EQ(other.scalar, result.scalar);
+		EXPECT_EQ(other.code, result.code);
+	}
+}
+
+TEST_F(ResultCacheTest, NonFiniteScoresRoundTrip)
+{
+	FaceImageQualityAssessment stored;
+	stored.qAssessments[QualityMeasure::Sharpness] = QualityMeasureResult(
+		std::numeric_limits<double>::quiet_NaN(), -1, QualityMeasureReturnCode::FailureToAssess);
+	stored.qAssessments[QualityMeasure::HeadSize] = QualityMeasureResult(
+		std::numeric_limits<double>::infinity(), 0, QualityMeasureReturnCode::Success);
+	stored.qAssessments[QualityMeasure::HeadPoseRoll] = QualityMeasureResult(
+		-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(),
+		QualityMeasureReturnCode::FailureToAssess);
+
+	FaceImageQualityAssessment loaded;
+	ASSERT_TRUE(RoundTrip(stored, loaded));
+
+	ASSERT_EQ(loaded.qAssessments.size(), 3);
+	EXPECT_TRUE(std::isnan(loaded.qAssessments.at(QualityMeasure::Sharpness).rawScore));
+	EXPECT_EQ(loaded.qAssessments.at(QualityMeasure::HeadSize).rawScore, std::numeric_limits<double>::infinity());
+	EXPECT_EQ(loaded.qAssessments.at(QualityMeasure::HeadPoseRoll).rawScore, -std::numeric_limits<double>::infinity());
+	EXPECT_TRUE(std::isnan(loaded.qAssessments.at(QualityMeasure::HeadPoseRoll).scalar));
+	EXPECT_EQ(loaded.qAssessments.at(QualityMeasure::Sharpness).code, QualityMeasureReturnCode::FailureToAssess);
+}
+
+TEST(ResultCacheKey, DependsOnImageAndConfiguration)
+{
+	Image image(2, 2, 8, std::shared_ptr<uint8_t[]>(new uint8_t[4]{1, 2, 3, 4}));
+	Image modified(2, 2, 8, std::shared_ptr<uint8_t[]>(new uint8_t[4]{1, 2, 3, 5}));
+	Image transposed(4, 1, 8, image.data);
+
+	OFIQ_LIB::ResultCache cache(1, "", 1);
+	OFIQ_LIB::ResultCache otherConfiguration(1, "", 2);
+	EXPECT_EQ(cache.Key(image), cache.Key(Image(2, 2, 8, image.data)));
+	EXPECT_NE(cache.Key(image), cache.Key(modified));
+	EXPECT_NE(cache.Key(image), cache.Key(transposed));
+	EXPECT_NE(cache.Key(image), otherConfiguration.Key(image));
+}
+
+TEST(HashBytes, PinnedValues)
+{
+	// the hash names persistent files and must not change between releases or platforms
+	std::vector<uint8_t> bytes(16);
+	std::iota(bytes.begin(), bytes.end(), uint8_t(0));
+
+	EXPECT_EQ(hashBytes(nullptr, 0), 0x8a3cf4470d20f1a9ULL);
+	EXPECT_EQ(hashBytes("OFIQ", 4), 0x3d0228b3254630a0ULL);
+	EXPECT_EQ(hashBytes(bytes.data(), bytes.size()), 0x45044efdca0b775eULL);
+	EXPECT_EQ(hashBytes(bytes.data(), 11, 42), 0x4f0feccdfd7263a6ULL);
+}
+
+TEST(HashBytes, DependsOnContentLengthAndSeed)
+{
+	std::vector<uint8_t> bytes(17, 7);
+	const uint64_t hash = hashBytes(bytes.data(), bytes.size());
+
+	EXPECT_EQ(hash, hashBytes(bytes.data(), bytes.size()));
+	EXPECT_NE(hash, hashBytes(bytes.data(), bytes.size() - 1));
+	EXPECT_NE(hash, hashBytes(bytes.data(), bytes.size(), 1));
+	bytes[16] = 8;
+	EXPECT_NE(hash, hashBytes(bytes.data(), bytes.size()));
+}
@@ -0,0 +1,67 @@
+/**
+ * @file test_segmentations.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "FaceParsing.h"
+
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <cstring>
+#include <vector>
+
+using OFIQ_LIB::modules::segmentations::FaceParsing;
+
+static void ExpectFusedBlobIsBitExact(const cv::Mat& imageBGR)
+{
+	constexpr int imageSize = 400;
+	cv::Mat imageRGB;
+	cv::cvtColor(imageBGR, imageRGB, cv::COLOR_BGR2RGB);
+	const cv::Mat expected = FaceParsing::CreateBlob(imageRGB, imageSize);
+
+	std::vector<float> blob;
+	FaceParsing::CreateFusedBlob(imageBGR, imageSize, blob);
+
+	ASSERT_EQ(blob.size(), expected.total());
+	EXPECT_EQ(std::memcmp(blob.data(), expected.ptr<float>(), blob.size() * sizeof(float)), 0);
+}
+
+TEST(FaceParsingBlob, FusedBlobOfRandomImageIsBitExact)
+{
+	cv::Mat image(556, 556, CV_8UC3);
+	cv::theRNG().state = 4711;
+	cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+	ExpectFusedBlobIsBitExact(image);
+}
+
+TEST(FaceParsingBlob, FusedBlobOfNetworkSizedImageIsBitExact)
+{
+	// all 8 bit values in every channel, as in the direct warp mode no resizing is done
+	cv::Mat image(400, 400, CV_8UC3);
+	for (int y = 0; y < image.rows; y++)
+		for (int x = 0; x < image.cols; x++)
+			image.at<cv::Vec3b>(y, x) = cv::Vec3b(
+				static_cast<uchar>(x + y), static_cast<uchar>(3 * x), static_cast<uchar>(255 - y));
+	ExpectFusedBlobIsBitExact(image);
+}
@@ -0,0 +1,187 @@
+/**
+ * @file test_utils.cpp
+ *
+ * @copyright Copyright (c) 2024  Federal Office for Information Security, Germany
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @author OFIQ development team
+ */
+
+#include "ClassCounts.h"
+#include "GeometryPlan.h"
+#include "OFIQError.h"
+#include "ofiq_structs.h"
+#include "RoiMask.h"
+
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+
+using namespace OFIQ_LIB;
+
+TEST(RoiMask, ConstructorClipsToImage)
+{
+	const cv::Size size(20, 10);
+	const RoiMask mask(size, cv::Rect(-3, 6, 8, 8));
+	EXPECT_EQ(mask.roi(), cv::Rect(0, 6, 5, 4));
+	EXPECT_EQ(mask.data().size(), mask.roi().size());
+	EXPECT_EQ(cv::countNonZero(mask.toMat()), 0);
+
+	const RoiMask filled(size, cv::Rect(2, 1, 3, 2), cv::Mat::ones(2, 3, CV_8UC1));
+	const cv::Mat full = filled.toMat();
+	EXPECT_EQ(full.size(), size);
+	EXPECT_EQ(cv::countNonZero(full), 6);
+	EXPECT_EQ(cv::countNonZero(full(cv::Rect(2, 1, 3, 2))), 6);
+
+	EXPECT_TRUE(RoiMask(size, cv::Rect(25, 2, 4, 4)).empty());
+	EXPECT_TRUE(RoiMask().empty());
+}
+
+TEST(RoiMask, FromMatRestrictsToNonZeroPixels)
+{
+	cv::Mat full = cv::Mat::zeros(20, 30, CV_8UC1);
+	full(cv::Rect(5, 4, 6, 3)) = 1;
+	full.at<uchar>(10, 12) = 1;
+
+	const RoiMask mask = RoiMask::FromMat(full);
+	EXPECT_EQ(mask.imageSize(), full.size());
+	EXPECT_EQ(mask.roi(), cv::Rect(5, 4, 8, 7));
+	EXPECT_EQ(mask.countNonZero(), 19);
+	EXPECT_EQ(cv::countNonZero(mask.toMat() != full), 0);
+
+	EXPECT_TRUE(RoiMask::FromMat(cv::Mat::zeros(20, 30, CV_8UC1)).empty());
+}
+
+TEST(RoiMask, PolygonsMatchFullSizeFilling)
+{
+	const cv::Size size(40, 30);
+	const std::vector<cv::Point2i> polygon = { {3, 2}, {25, 5}, {20, 22}, {6, 18} };
+
+	cv::Mat expected = cv::Mat::zeros(size, CV_8UC1);
+	cv::fillConvexPoly(expected, polygon, cv::Scalar(1));
+	const RoiMask convex = RoiMask::FromConvexPolygon(size, polygon);
+	EXPECT_EQ(cv::countNonZero(convex.toMat() != expected), 0);
+
+	// polygons reaching outside of the image are clipped
+	const std::vector<std::vector<cv::Point2i>> polygons = { polygon, { {30, -5}, {45, 10}, {35, 12} } };
+	expected = cv::Mat::zeros(size, CV_8UC1);
+	cv::fillPoly(expected, polygons, cv::Scalar(1));
+	const RoiMask filled = RoiMask::FromPolygons(size, polygons);
+	EXPECT_TRUE(cv::Rect(cv::Point(0, 0), size).contains(filled.roi().br() - cv::Point(1, 1)));
+	EXPECT_EQ(cv::countNonZero(filled.toMat() != expected), 0);
+}
+
+TEST(RoiMask, CountsMatchFullSizeOperations)
+{
+	const cv::Size size(32, 24);
+	const RoiMask mask(size, cv::Rect(4, 3, 10, 8), cv::Mat::ones(8, 10, CV_8UC1));
+	const RoiMask other(size, cv::Rect(10, 6, 12, 12), cv::Mat::ones(12, 12, CV_8UC1));
+	const cv::Mat otherFull = other.toMat();
+
+	EXPECT_EQ(mask.countNonZero(), 80);
+	EXPECT_EQ(mask.countIntersection(otherFull), cv::countNonZero(mask.toMat() & otherFull));
+	EXPECT_EQ(mask.countIntersection(other), mask.countIntersection(otherFull));
+	EXPECT_EQ(mask.countIntersection(other), 20);
+	EXPECT_EQ(mask.countDifference(otherFull), cv::countNonZero(mask.toMat().mul(1 - otherFull)));
+	EXPECT_EQ(mask.countIntersection(RoiMask(size, cv::Rect(20, 20, 2, 2))), 0);
+}
+
+TEST(ClassCounts, CountsLabelsPerRowRange)
+{
+	cv::Mat labels(6, 5, CV_8UC1, cv::Scalar(0));
+	labels.row(1).setTo(3);
+	labels.row(4).setTo(3);
+	labels.at<uchar>(2, 2) = 18;
+	labels.at<uchar>(5, 0) = 25;
+	labels.at<uchar>(5, 1) = 200;
+
+	const ClassCounts counts = ClassCounts::FromImage(labels);
+	ASSERT_EQ(counts.rows(), 6);
+	EXPECT_EQ(counts.count(3), 10);
+	EXPECT_EQ(counts.count(3, 0, 2), 5);
+	EXPECT_EQ(counts.count(3, 2, 4), 0);
+	EXPECT_EQ(counts.count(18), 1);
+	EXPECT_EQ(counts.count(25), 1);
+	EXPECT_EQ(counts.count(0), 30 - 10 - 1 - 2);
+	for (int label = 0; label < ClassCounts::numberOfLabels; label++)
+		EXPECT_EQ(counts.count(label), cv::countNonZero(labels == label)) << "label " << label;
+
+	// ranges are clipped, uncounted labels are 0
+	EXPECT_EQ(counts.count(3, -5, 100), 10);
+	EXPECT_EQ(counts.count(3, 4, 2), 0);
+	EXPECT_EQ(counts.count(200), 0);
+	EXPECT_EQ(counts.count(-1), 0);
+}
+
+TEST(ClassCounts, RejectsInvalidLabelImages)
+{
+	EXPECT_TRUE(ClassCounts::FromImage(cv::Mat()).empty());
+	EXPECT_THROW(ClassCounts::FromImage(cv::Mat::zeros(4, 4, CV_32FC1)), OFIQError);
+}
+
+TEST(QualityMeasureSelection, AllSelectsEverySlot)
+{
+	const auto all = OFIQ::QualityMeasureSelection::All();
+	for (size_t i = 0; i < OFIQ::DenseQualityAssessments::Capacity; i++)
+		EXPECT_TRUE(all.contains(OFIQ::DenseQualityAssessments::MeasureAt(i))) << "slot " << i;
+	EXPECT_EQ(uint64_t{ all.mask } >> OFIQ::DenseQualityAssessments::Capacity, 0u);
+	EXPECT_FALSE(all.contains(OFIQ::QualityMeasure::NotSet));
+}
+
+TEST(GeometryPlan, ComposesCropAndResize)
+{
+	GeometryPlan plan(cv::Matx23d(2, 0, 10, 0, 2, 20), cv::Size(616, 616));
+	plan.crop(cv::Rect(30, 0, 556, 556)).resize(cv::Size(278, 278));
+	EXPECT_EQ(plan.size(), cv::Size(278, 278));
+
+	// halving maps the source position p to 0.5 * p - 0.25 as cv::resize
+	const cv::Matx23d expected(1, 0, -10.25, 0, 1, 9.75);
+	for (int i = 0; i < 2; i++)
+		for (int j = 0; j < 3; j++)
+			EXPECT_NEAR(plan.transform()(i, j), expected(i, j), 1e-12) << i << "," << j;
+}
+
+TEST(GeometryPlan, DirectWarpStaysCloseToChainedResampling)
+{
+	cv::Mat source(512, 512, CV_8UC3);
+	cv::theRNG().state = 4711;
+	cv::randu(source, cv::Scalar::all(0), cv::Scalar::all(256));
+	cv::GaussianBlur(source, source, cv::Size(7, 7), 0);
+	cv::Mat alignment = cv::getRotationMatrix2D(cv::Point2f(256, 256), 10, 1.2);
+	cv::Matx23d transform;
+	cv::Mat transformView(transform, false);
+	alignment.convertTo(transformView, CV_64F);
+
+	// face parsing input: crop of the aligned face resized to 400 x 400
+	const cv::Size alignedSize(GeometryPlan::alignedFaceSize, GeometryPlan::alignedFaceSize);
+	const cv::Rect crop(30, 0, 556, 556);
+	cv::Mat aligned;
+	cv::warpAffine(source, aligned, alignment, alignedSize);
+	cv::Mat chained;
+	cv::resize(aligned(crop), chained, cv::Size(400, 400));
+	const cv::Mat direct = GeometryPlan(transform, alignedSize).crop(crop).resize(cv::Size(400, 400)).warp(source);
+
+	// interpolating once instead of twice changes the pixels by about half a grey level on average
+	cv::Mat difference;
+	cv::absdiff(chained, direct, difference);
+	const cv::Scalar meanDifference = cv::mean(difference);
+	for (int c = 0; c < 3; c++)
+		EXPECT_LT(meanDifference[c], 1.0) << "channel " << c;
+}